@@ -0,0 +1,82 @@
+#include "BotClient.h"
+#include "Scene.h"
+#include "Level.h"
+
+BotClient::BotClient(int index, unsigned int seed)
+    : scene(std::make_unique<Scene>(network)),
+      id(100000 + index),  // ID provvisorio: il server assegna quello reale col LOGIN
+      rng(seed),
+      actionTimer(0.f),
+      // Sfasa i ping dei bot, così non partono tutti nello stesso tick
+      pingTimer(PingInterval * static_cast<float>(index % 10) / 10.f)
+{
+    scene->setLocalPlayerId(id);
+    scene->setIsHost(false);
+
+    auto player = std::make_unique<Player>(scene->getKinematics(), scene->getAnimator(), network,
+                                           "PM1", "Bot" + std::to_string(index), true);
+    player->setId(id);
+    player->setInputSource([this]() { return input; });
+    scene->addEntity(std::move(player));
+
+    // Stessa mappa del gioco: le collisioni (e quindi i pacchetti di movimento) sono realistiche
+    Level::build(*scene);
+}
+
+BotClient::~BotClient() = default;
+
+bool BotClient::connect(const std::string& host, unsigned short port, bool compactState)
+{
+    network.setCompactStateEnabled(compactState);
+    return network.connect(host, port);
+}
+
+// Sceglie la prossima azione dello script e per quanto tempo mantenerla
+PlayerInput BotClient::nextAction()
+{
+    std::uniform_int_distribution<int> actionDist(0, 5);
+    std::uniform_real_distribution<float> durationDist(0.2f, 1.2f);
+
+    PlayerInput action;
+    switch (actionDist(rng))
+    {
+    case 0: action.left = true; break;                         // cammina a sinistra
+    case 1: action.right = true; break;                        // cammina a destra
+    case 2: action.left = true; action.jump = true; break;     // salta a sinistra
+    case 3: action.right = true; action.jump = true; break;    // salta a destra
+    case 4: action.attack = true; break;                       // attacca sul posto
+    default: break;                                            // fermo
+    }
+    actionTimer = durationDist(rng);
+    return action;
+}
+
+void BotClient::update(float dt)
+{
+    actionTimer -= dt;
+    if (actionTimer <= 0.f)
+    {
+        input = nextAction();
+    }
+
+    if (network.isConnected())
+    {
+        pingTimer -= dt;
+        if (pingTimer <= 0.f)
+        {
+            network.sendPing();
+            pingTimer += PingInterval;
+        }
+    }
+
+    scene->setDt(dt);
+    scene->update();
+    network.flush(); // come Game::update: una scrittura per tick
+
+    // Un bot morto non finisce la partita: riparte subito
+    Player* player = scene->getLocalPlayerInScene();
+    if (player && player->isDead())
+    {
+        scene->respawnLocalPlayer();
+    }
+}
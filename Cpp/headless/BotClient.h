@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <random>
+#include <string>
+
+#include "NetworkClient.h"
+#include "Player.h"
+
+class Scene;
+
+// Un giocatore finto per i test di carico: connessione, scena e player locale propri.
+// L'input arriva da uno script (cammina, salta, attacca) invece che dalla tastiera.
+class BotClient
+{
+private:
+    // Dichiarata prima della scena: la scena (e i suoi attori) la usano fino alla distruzione
+    NetworkClient network;
+    std::unique_ptr<Scene> scene;
+    int id;
+
+    // Stato dello script di input
+    std::mt19937 rng;
+    PlayerInput input;   // letto dal player ad ogni tick
+    float actionTimer;   // tempo rimasto all'azione corrente
+    float pingTimer;
+
+    PlayerInput nextAction();
+
+public:
+    // Intervallo fra due PING (misura della latenza)
+    static constexpr float PingInterval = 0.5f;
+
+    BotClient(int index, unsigned int seed);
+    ~BotClient();
+    BotClient(const BotClient&) = delete;
+    BotClient& operator=(const BotClient&) = delete;
+
+    // compactState = false: il bot si presenta come un client vecchio (niente stato compatto)
+    bool connect(const std::string& host, unsigned short port, bool compactState = true);
+    // Un tick di simulazione: rete, input scriptato, fisica, invio dello stato
+    void update(float dt);
+
+    int getId() const { return id; }
+    NetworkStats getStats() const { return network.getStats(); }
+    bool isConnected() const { return network.isConnected(); }
+};
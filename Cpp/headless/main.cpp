@@ -0,0 +1,150 @@
+// Client headless per i test di carico: N player scriptati in un solo processo,
+// nessuna finestra. Stampa ogni secondo il traffico e la latenza di ogni bot.
+//
+// Uso: APL_Bots <host> [porta=8080] [bot=50] [secondi=0 (infinito)] [compatto=1]
+// compatto=0 usa il vecchio formato dei pacchetti di stato (confronto del traffico)
+
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BotClient.h"
+#include "Game.h"
+#include "TextureCache.h"
+#include "CharacterAtlas.h"
+#include "ParticleSystem.h"
+#include "AnimationClip.h"
+
+// Stesso passo fisso del gioco
+constexpr float SIMULATION_DT = 1.f / 60.f;
+constexpr float REPORT_INTERVAL = 1.f;
+// Massimo di tick recuperati in un frame (evita la "spirale" con tanti bot su una macchina carica)
+constexpr int MAX_TICKS_PER_FRAME = 5;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Uso: " << argv[0] << " <host> [porta=8080] [bot=50] [secondi=0] [compatto=1]" << std::endl;
+        return 1;
+    }
+    std::string host = argv[1];
+    unsigned short port = argc > 2 ? static_cast<unsigned short>(std::atoi(argv[2])) : 8080;
+    int botCount = argc > 3 ? std::max(1, std::atoi(argv[3])) : 50;
+    float duration = argc > 4 ? static_cast<float>(std::atof(argv[4])) : 0.f;
+    bool compact = argc > 5 ? std::atoi(argv[5]) != 0 : true;
+
+    // Game senza finestra: niente texture su GPU, particelle, HUD e focus
+    Game::createHeadless();
+
+    std::vector<std::unique_ptr<BotClient>> bots;
+    bots.reserve(botCount);
+    for (int i = 0; i < botCount; i++)
+    {
+        auto bot = std::make_unique<BotClient>(i, 1234u + static_cast<unsigned int>(i));
+        if (!bot->connect(host, port, compact))
+        {
+            std::cerr << "Bot " << i << ": connessione fallita" << std::endl;
+            continue;
+        }
+        bots.push_back(std::move(bot));
+    }
+    if (bots.empty())
+    {
+        std::cerr << "Nessun bot connesso a " << host << ":" << port << std::endl;
+        return 1;
+    }
+    std::cout << bots.size() << " bot connessi a " << host << ":" << port << std::endl;
+
+    // Contatori dell'ultimo report, per calcolare i tassi al secondo
+    std::vector<NetworkStats> lastStats(bots.size());
+
+    sf::Clock clock;
+    sf::Clock runClock;
+    float accumulator = 0.f;
+    float reportTimer = 0.f;
+    sf::Clock updateClock;
+    float updateSeconds = 0.f; // tempo speso nelle update (costo di Scene::update per N bot)
+    while (duration <= 0.f || runClock.getElapsedTime().asSeconds() < duration)
+    {
+        float frameTime = clock.restart().asSeconds();
+        accumulator += frameTime;
+        reportTimer += frameTime;
+
+        updateClock.restart();
+        int ticks = 0;
+        while (accumulator >= SIMULATION_DT && ticks < MAX_TICKS_PER_FRAME)
+        {
+            for (auto& bot : bots)
+                bot->update(SIMULATION_DT);
+            accumulator -= SIMULATION_DT;
+            ticks++;
+        }
+        // Se siamo troppo indietro scartiamo il tempo residuo invece di accumularlo
+        if (ticks == MAX_TICKS_PER_FRAME && accumulator > SIMULATION_DT)
+            accumulator = 0.f;
+        updateSeconds += updateClock.getElapsedTime().asSeconds();
+
+        if (reportTimer >= REPORT_INTERVAL)
+        {
+            NetworkStats total;
+            float worstRtt = 0.f;
+            float rttSum = 0.f;
+            int connectedBots = 0;
+            std::printf("---- %.0fs ----\n", runClock.getElapsedTime().asSeconds());
+            std::printf("%6s %9s %11s %9s %11s %9s %9s\n", "bot", "send p/s", "send B/s", "recv p/s", "recv B/s", "rtt avg", "rtt max");
+            for (std::size_t i = 0; i < bots.size(); i++)
+            {
+                const NetworkStats& stats = bots[i]->getStats();
+                const NetworkStats& last = lastStats[i];
+                std::printf("%6d %9.0f %11.0f %9.0f %11.0f %7.1fms %7.1fms%s\n",
+                            bots[i]->getId(),
+                            (stats.packetsSent - last.packetsSent) / reportTimer,
+                            (stats.bytesSent - last.bytesSent) / reportTimer,
+                            (stats.packetsReceived - last.packetsReceived) / reportTimer,
+                            (stats.bytesReceived - last.bytesReceived) / reportTimer,
+                            stats.averageRttMs, stats.maxRttMs,
+                            bots[i]->isConnected() ? "" : " (disconnesso)");
+
+                total.packetsSent += stats.packetsSent - last.packetsSent;
+                total.bytesSent += stats.bytesSent - last.bytesSent;
+                total.sendCalls += stats.sendCalls - last.sendCalls;
+                total.packetsReceived += stats.packetsReceived - last.packetsReceived;
+                total.bytesReceived += stats.bytesReceived - last.bytesReceived;
+                worstRtt = std::max(worstRtt, stats.maxRttMs);
+                if (bots[i]->isConnected())
+                {
+                    rttSum += stats.averageRttMs;
+                    connectedBots++;
+                }
+                lastStats[i] = stats;
+            }
+            std::printf("TOTALE %9.0f %11.0f %9.0f %11.0f %7.1fms %7.1fms  | %d/%zu connessi, %.0f write/s, update %.1f%%\n",
+                        total.packetsSent / reportTimer, total.bytesSent / reportTimer,
+                        total.packetsReceived / reportTimer, total.bytesReceived / reportTimer,
+                        connectedBots > 0 ? rttSum / connectedBots : 0.f, worstRtt,
+                        connectedBots, bots.size(), total.sendCalls / reportTimer,
+                        100.f * updateSeconds / reportTimer);
+            std::fflush(stdout);
+            reportTimer = 0.f;
+            updateSeconds = 0.f;
+        }
+
+        // Dormi fino al prossimo tick
+        sf::sleep(sf::seconds(SIMULATION_DT - accumulator));
+    }
+
+    // Pulizia: i bot (scene e connessioni) prima dei singleton che usano
+    bots.clear();
+    Game::destroyInstance();
+    TextureCache::destroyInstance();
+    ParticleSystem::destroyInstance();
+    AnimationLibrary::destroyInstance();
+    CharacterAtlas::destroyInstance();
+    return 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AtlasFrame;
+
+// Una clip di animazione: frame nell'atlas, durata di ogni frame, loop e ritaglio.
+// Le clip sono immutabili e condivise da tutti gli attori che usano la stessa cartella:
+// lo stato di riproduzione (frame corrente, timer) sta nell'Animator.
+struct AnimationClip
+{
+    std::vector<const AtlasFrame*> frames;
+    float frameDuration = 0.1f;
+    bool loop = true;          // false: si ferma sull'ultimo frame e risulta "finita"
+    sf::IntRect crop;          // parte del frame 96x54 occupata dal personaggio
+};
+
+enum class ClipId
+{
+    Idle,
+    Walk,
+    Jump,
+    Fall,
+    Attack,
+    Count
+};
+
+// Tabella delle clip di un personaggio (una cartella PM* con un certo set di animazioni)
+struct CharacterClips
+{
+    AnimationClip clips[static_cast<int>(ClipId::Count)];
+
+    const AnimationClip& operator[](ClipId id) const { return clips[static_cast<int>(id)]; }
+};
+
+// Set di animazioni: player ed enemy usano le stesse immagini con tempi diversi
+enum class CharacterKind
+{
+    Player,
+    Enemy
+};
+
+// Costruisce le tabelle di clip a partire dalle definizioni in AnimationClip.cpp
+// e le tiene in cache per (cartella, tipo): il primo attore le crea, gli altri le condividono.
+class AnimationLibrary
+{
+    //Implements the singleton pattern
+    private:
+        static AnimationLibrary* instance;
+
+        std::unordered_map<std::string, CharacterClips> tables; // chiave: "PM1/player"
+
+        AnimationLibrary() = default;
+
+    public:
+        static AnimationLibrary* getInstance();
+        static void destroyInstance();
+
+        const CharacterClips& getClips(const std::string& folder, CharacterKind kind);
+};
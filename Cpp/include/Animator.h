@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstdint>
+
+struct AnimationClip;
+
+// Stato di riproduzione delle animazioni di tutti gli attori, in array contigui (SoA)
+// come Kinematics. Ogni attore tiene solo l'indice del proprio animator, sceglie la clip
+// con play() e l'orientamento con setFacingRight(); update() avanza tutti gli animator
+// in una passata e tocca lo sprite solo di quelli il cui frame (o verso) è cambiato.
+class Animator
+{
+private:
+    std::vector<const AnimationClip*> clip;
+    std::vector<sf::Sprite*> sprite;
+    std::vector<float> timer;
+    std::vector<uint16_t> frame;
+    std::vector<uint8_t> facingRight;
+    std::vector<uint8_t> playing;
+    std::vector<uint8_t> finished;
+    std::vector<uint8_t> dirty;   // lo sprite va aggiornato al prossimo update()
+    std::vector<uint8_t> inUse;
+    std::vector<uint32_t> freeList;
+
+    void apply(uint32_t animator);
+
+public:
+    Animator() = default;
+    Animator(const Animator&) = delete;
+    Animator& operator=(const Animator&) = delete;
+
+    // Lo sprite deve restare allo stesso indirizzo finché l'animator esiste
+    uint32_t createAnimator(sf::Sprite& target, const AnimationClip& initialClip);
+    void destroyAnimator(uint32_t animator);
+
+    // Avvia la clip; se è già quella in corso non la riavvia (a meno di 'restart')
+    void play(uint32_t animator, const AnimationClip& newClip, bool restart = false);
+    // Congela il frame corrente (es. durante la morte), play() riprende
+    void pause(uint32_t animator) { playing[animator] = 0; }
+    void setFacingRight(uint32_t animator, bool value)
+    {
+        uint8_t flag = value ? 1 : 0;
+        if (facingRight[animator] != flag)
+        {
+            facingRight[animator] = flag;
+            dirty[animator] = 1;
+        }
+    }
+    // Vero quando una clip senza loop ha superato l'ultimo frame
+    bool isFinished(uint32_t animator) const { return finished[animator] != 0; }
+
+    void update(float dt);
+};
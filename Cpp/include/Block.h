@@ -2,6 +2,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
+#include <memory>
 #include "GameObject.h"
 
 class Block: public GameObject
@@ -10,10 +11,13 @@ class Block: public GameObject
         //sprite already holds x,y,width and height
         //no point in duplicating them here
         sf::Sprite sprite;
-        sf::Texture texture;
+        std::shared_ptr<const sf::Texture> texture; // condivisa tramite TextureCache
+        sf::FloatRect bounds; // dalla dimensione dell'immagine: valido anche senza texture (headless)
     public:
         Block(float x, float y, const std::string& texturePath);
         sf::FloatRect getBounds() const;
-        void draw(sf::RenderWindow& window) override;
+        // Usati dal TileLayer per costruire il vertex array della mappa
+        const sf::Texture* getTexture() const { return texture.get(); }
+        sf::IntRect getTextureRect() const { return sprite.getTextureRect(); }
         void update(const Scene& scene) override;
 };
\ No newline at end of file
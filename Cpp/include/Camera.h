@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+// Telecamera 2D: una sf::View centrata sul player locale, limitata ai bordi del livello.
+// Se il livello è più piccolo della finestra lungo un asse, resta centrata sul livello.
+class Camera
+{
+private:
+    sf::View view;
+    sf::FloatRect worldBounds;
+    bool hasWorldBounds;
+
+public:
+    Camera();
+
+    void setWorldBounds(const sf::FloatRect& bounds);
+
+    // Centra la vista su 'target' con dimensioni pari a 'viewportSize' (la finestra)
+    void follow(const sf::Vector2f& target, const sf::Vector2f& viewportSize);
+
+    const sf::View& getView() const { return view; }
+    // Rettangolo del mondo attualmente visibile (per il culling)
+    sf::FloatRect getVisibleArea() const;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Un frame di animazione dentro l'atlas: pagina (texture) + rettangolo del frame intero.
+// I ritagli dei personaggi (es. IntRect(41,24,15,30)) restano relativi all'angolo del frame.
+struct AtlasFrame
+{
+    const sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+
+    // Rettangolo nella pagina corrispondente a un ritaglio relativo al frame
+    sf::IntRect crop(const sf::IntRect& area) const
+    {
+        return sf::IntRect(rect.left + area.left, rect.top + area.top, area.width, area.height);
+    }
+};
+
+// Atlas dei frame dei personaggi (assets/pp1/PM*): tutti i frame vengono impacchettati
+// in poche texture grandi ("pagine"), così player e nemici condividono la stessa texture
+// e possono essere disegnati insieme in un unico vertex array (vedi SpriteBatch).
+// I frame si caricano su richiesta e vengono copiati nella prima pagina con spazio libero.
+class CharacterAtlas
+{
+    //Implements the singleton pattern
+    private:
+        static CharacterAtlas* instance;
+
+        static constexpr unsigned PageSize = 1024;
+        static constexpr unsigned Padding = 2; // spazio fra i frame, evita sbavature col filtering
+
+        std::vector<std::unique_ptr<sf::Texture>> pages;
+        // Cursore dello "shelf packing" nella pagina corrente
+        unsigned cursorX, cursorY, rowHeight;
+
+        std::unordered_map<std::string, AtlasFrame> frames; // chiave: "PM1/Idle"
+        sf::Texture missingTexture; // usata dai frame che non si sono potuti caricare
+        bool headless;
+
+        CharacterAtlas();
+        bool pack(const sf::Image& image, AtlasFrame& frame);
+        void addPage();
+
+    public:
+        static CharacterAtlas* getInstance();
+        static void destroyInstance();
+
+        // Frame 'name' (es. "Walk_1") del personaggio in 'folder' (es. "PM1").
+        // Se il file non esiste ritorna un frame vuoto (texture trasparente) ed errore su cerr.
+        // Il riferimento resta valido per tutta la vita dell'atlas.
+        const AtlasFrame& getFrame(const std::string& folder, const std::string& name);
+
+        // Headless (bot, server dedicato): nessuna immagine caricata, tutti i frame puntano a
+        // una texture vuota. I ritagli restano validi, quindi collider e animazioni funzionano.
+        void setHeadless(bool enabled) { headless = enabled; }
+
+        std::size_t getPageCount() const { return pages.size(); }
+        std::size_t getFrameCount() const { return frames.size(); }
+};
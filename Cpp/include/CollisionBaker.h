@@ -0,0 +1,10 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Fonde i collider dei blocchi adiacenti in pochi rettangoli solidi.
+// Prima unisce le file orizzontali (stessa y e altezza, blocchi contigui),
+// poi impila le file che hanno stessa x e larghezza e si toccano in verticale.
+// La fisica usa i rettangoli fusi; il rendering continua a usare i singoli blocchi.
+std::vector<sf::FloatRect> bakeCollisionRects(std::vector<sf::FloatRect> tiles);
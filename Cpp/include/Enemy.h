@@ -7,35 +7,35 @@
 
 class Block;
 class Scene;
+class Kinematics;
+class Animator;
+class NetworkClient;
+struct EnemyNetState;
+struct CharacterClips;
+struct ActorSnapshot;
 
 class Enemy : public Hittable
 {
     private:
+        // Posizione, velocità e collider stanno nel sistema Kinematics della scena
+        Kinematics& kinematics;
+        uint32_t body;
         sf::Sprite sprite;
-        sf::Vector2f velocity;
 
-        sf::Texture idle_texture;
-        std::vector<sf::Texture> walk_textures;
-        std::vector<sf::Texture> attack_textures;
+        // Clip condivise fra tutti i nemici (AnimationLibrary); la riproduzione sta nell'Animator
+        Animator& animations;
+        uint32_t animator;
+        const CharacterClips* clips;
 
-        // Collider
-        float colliderOffsetX;
-        float colliderOffsetY;
+        // Connessione su cui l'host invia stato e danni del nemico
+        NetworkClient& network;
 
-        // Animation
-        int current_animation_frame;
-        float animation_timer, animation_speed;
-
-        // Physics
-        bool isGrounded;
-        float speed, gravity;
+        // Movimento
+        float speed;
         bool facingRight;
 
         // Attack state
         bool isAttacking;
-        size_t attackFrame;
-        float attackTimer;
-        static constexpr float attackFrameDuration = 0.15f;
         sf::FloatRect attackHitbox;
         float attackCooldownTimer;
         float attackCooldown; // Random tra 1.0 e 2.5 secondi
@@ -54,21 +54,21 @@ class Enemy : public Hittable
         uint32_t enemyId;
         bool isLocallyControlled; // Solo un client controlla l'AI
 
-        void apply_gravity(float dt);
-        void moveX(float dt, const std::vector<Block*>& blocks);
-        void moveY(float dt, const std::vector<Block*>& blocks);
-        void updateAnimation(float dt);
-        void updateCollider();
+        void updateAnimation();
         void updateAI(float dt, const Scene& scene);
         void attack(const Scene& scene);
         void setAttackAnimation();
+        void randomizeBehaviour();
+        void applyDeathFade();
 
     public:
-        Enemy(std::string Folder, uint32_t id = 0, bool localControl = true);
+        Enemy(Kinematics& kinematics, Animator& animations, NetworkClient& network,
+              std::string Folder, uint32_t id = 0, bool localControl = true);
+        ~Enemy() override;
         void update(const Scene& scene) override;
-        void draw(sf::RenderWindow& window) override;
-        sf::FloatRect getBounds() const { return collider; }
-        sf::FloatRect collider;
+        void lateUpdate(const Scene& scene) override;
+        void captureRender(ActorSnapshot& out);
+        sf::FloatRect getBounds() const;
 
         // Network methods
         uint32_t getId() const { return enemyId; }
@@ -76,18 +76,25 @@ class Enemy : public Hittable
         bool isLocalControl() const { return isLocallyControlled; }
         void setLocalControl(bool local) { isLocallyControlled = local; }
         
+        // Stato da spedire nello snapshot dei nemici (solo host)
+        void captureNetState(EnemyNetState& out) const;
+
         // Sync from network
         void syncFromNetwork(float x, float y, float velX, float velY, 
                              bool faceRight, bool grounded, bool attacking, float health);
         
         // Posizione iniziale
         void setInitialPosition(float x, float y);
+
+        // Pool (vedi Scene::spawnEnemy): riuso di un'istanza senza ricaricare le texture
+        void reset(uint32_t id, bool localControl, float x, float y);
+        void deactivate();
         
         // Getters for network sync
-        sf::Vector2f getPosition() const { return sprite.getPosition(); }
-        sf::Vector2f getVelocity() const { return velocity; }
+        sf::Vector2f getPosition() const override;
+        sf::Vector2f getVelocity() const;
         bool isFacingRight() const { return facingRight; }
-        bool getIsGrounded() const { return isGrounded; }
+        bool getIsGrounded() const;
         bool getIsAttacking() const { return isAttacking; }
 
         enum class EnemyState
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// Riferimento "debole" a un'entità della Scene: indice dello slot + generazione.
+// Quando l'entità viene rimossa la generazione dello slot avanza, quindi un handle
+// vecchio non risolve più (Scene::getEntity ritorna nullptr) invece di puntare
+// a memoria liberata o a un'altra entità che ha riusato lo slot.
+struct EntityHandle
+{
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == InvalidIndex; }
+
+    bool operator==(const EntityHandle& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
@@ -2,6 +2,8 @@
 
 #include <SFML/Graphics.hpp>
 
+#include "RenderSnapshot.h"
+
 //#include "GameObject.h"
 
 class Scene;
@@ -30,10 +32,16 @@ class Game
         sf::Text levelText;
         sf::Text restartText;
         sf::Text hostText;
+        // I testi dell'HUD si ricostruiscono solo quando cambia lo stato che mostrano
+        HudState drawnHud;
+        void refreshHud(const HudState& hud);
 
     public:
         ~Game();
         static Game* getInstance(sf::RenderWindow* window = nullptr);
+        // Istanza senza finestra (bot, server dedicato): stato di gioco sì, HUD no.
+        // Mette in modalità headless anche texture, atlas e particelle.
+        static Game* createHeadless();
         static void destroyInstance();
         void update(float dt);
         void setScene(Scene* newScene);
@@ -50,6 +58,10 @@ class Game
         void enemyDefeated();
         bool isGameWon() const;
         void drawUI();
+        // Stato mostrato dall'HUD, copiato nel RenderSnapshot
+        HudState getHudState() const;
+        // Disegna l'HUD da uno snapshot (thread di render)
+        void drawHud(sf::RenderTarget& target, const HudState& hud);
         
         // Sistema livelli
         int getCurrentLevel() const;
@@ -2,6 +2,8 @@
 
 #include <SFML/Graphics.hpp>
 
+#include "EntityHandle.h"
+
 class Scene;
 
 class GameObject 
@@ -9,5 +11,13 @@ class GameObject
     public:
         virtual ~GameObject() = default;
         virtual void update(const Scene& scene) = 0;
-        virtual void draw(sf::RenderWindow& window) = 0;
+        // Chiamata dopo lo step della fisica (posizioni e contatti già aggiornati)
+        virtual void lateUpdate(const Scene& scene) {}
+
+        // Handle assegnato dalla Scene quando l'entità viene aggiunta
+        EntityHandle getHandle() const { return handle; }
+
+    private:
+        friend class Scene;
+        EntityHandle handle;
 };
@@ -14,6 +14,9 @@ protected:
     float deathTimer;
     static constexpr float deathDuration = 2.0f;
 
+    // Effetto visivo del colpo, da chiamare ovunque si applichi danno
+    void spawnHitEffect();
+
 public:
     Hittable(float maxHealth = 100.f);
     virtual ~Hittable() = default;
@@ -30,6 +33,9 @@ public:
 
     virtual void onDeath();
 
+    // Posizione logica dell'entità (usata anche per gli effetti di colpo/morte)
+    virtual sf::Vector2f getPosition() const = 0;
+
     bool isDead() const { return dead; }
     bool isDying() const { return dying; }
     float getDeathProgress() const { return dying ? (deathTimer / deathDuration) : 0.f; }
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstdint>
+
+class Scene;
+
+// Stato cinematico di tutti gli attori (player e nemici) in array contigui (SoA).
+// Player ed Enemy tengono solo l'indice del proprio "body" e leggono/scrivono qui
+// posizione, velocità e flag di contatto col terreno.
+//
+// step() integra gravità e velocità per tutti i body in passate lineari sugli array
+// (senza salti tra oggetti polimorfici, quindi vettorizzabili), poi risolve le
+// collisioni con i rettangoli solidi della scena, prima in X e poi in Y.
+class Kinematics
+{
+private:
+    // Posizione = centro del collider (coincide con l'origine dello sprite)
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY; // posizione al tick precedente (interpolazione del render)
+    std::vector<float> velX, velY;
+    std::vector<float> halfW, halfH;
+    std::vector<float> gravity;
+    std::vector<float> simMask;   // 1 se il body è simulato localmente, 0 altrimenti
+    std::vector<uint8_t> grounded;
+    std::vector<int8_t> blockedX; // -1/+1 se nell'ultimo step ha urtato un muro a sinistra/destra
+    std::vector<uint8_t> inUse;
+    std::vector<uint32_t> freeList;
+
+    void resolveX(uint32_t body, float dx, const Scene& scene);
+    void resolveY(uint32_t body, float dy, const Scene& scene);
+
+public:
+    Kinematics() = default;
+    Kinematics(const Kinematics&) = delete;
+    Kinematics& operator=(const Kinematics&) = delete;
+
+    uint32_t createBody(float width, float height, float gravityValue);
+    void destroyBody(uint32_t body);
+
+    // Chiamata all'inizio di ogni tick di simulazione, prima di rete e fisica:
+    // la posizione corrente diventa quella "precedente" per l'interpolazione
+    void beginTick();
+    void step(float dt, const Scene& scene);
+
+    // Accesso al singolo body
+    sf::Vector2f getPosition(uint32_t body) const { return sf::Vector2f(posX[body], posY[body]); }
+    void setPosition(uint32_t body, float x, float y) { posX[body] = x; posY[body] = y; }
+    // Come setPosition ma senza interpolare dal punto precedente (spawn, respawn)
+    void teleport(uint32_t body, float x, float y)
+    {
+        posX[body] = prevX[body] = x;
+        posY[body] = prevY[body] = y;
+    }
+    // Posizione da disegnare: alpha in [0,1] è la frazione di tick trascorsa dall'ultimo update
+    sf::Vector2f getInterpolatedPosition(uint32_t body, float alpha) const
+    {
+        return sf::Vector2f(prevX[body] + (posX[body] - prevX[body]) * alpha,
+                            prevY[body] + (posY[body] - prevY[body]) * alpha);
+    }
+    sf::Vector2f getPreviousPosition(uint32_t body) const { return sf::Vector2f(prevX[body], prevY[body]); }
+    sf::Vector2f getVelocity(uint32_t body) const { return sf::Vector2f(velX[body], velY[body]); }
+    void setVelocity(uint32_t body, float vx, float vy) { velX[body] = vx; velY[body] = vy; }
+    void setVelocityX(uint32_t body, float vx) { velX[body] = vx; }
+    void setVelocityY(uint32_t body, float vy) { velY[body] = vy; }
+    bool isGrounded(uint32_t body) const { return grounded[body] != 0; }
+    void setGrounded(uint32_t body, bool value) { grounded[body] = value ? 1 : 0; }
+    int getBlockedX(uint32_t body) const { return blockedX[body]; }
+    bool isSimulated(uint32_t body) const { return simMask[body] != 0.f; }
+    void setSimulated(uint32_t body, bool value) { simMask[body] = value ? 1.f : 0.f; }
+    sf::FloatRect getCollider(uint32_t body) const
+    {
+        return sf::FloatRect(posX[body] - halfW[body], posY[body] - halfH[body],
+                             halfW[body] * 2.f, halfH[body] * 2.f);
+    }
+
+    std::size_t capacity() const { return posX.size(); }
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+class Scene;
+
+// Punti di spawn possibili per i nemici
+struct SpawnPoint {
+    float x, y;
+};
+
+// Il livello di gioco: mappa, effetti ambientali e spawn dei nemici.
+// Condiviso fra il gioco e i client headless (bot di carico), così tutti simulano la stessa mappa.
+class Level
+{
+public:
+    // Tetto di nemici per livello (AI e combattimento interrogano la broadphase, non tutti gli attori)
+    static constexpr int MaxEnemiesPerLevel = 40;
+
+    // Dimensioni della mappa (i bordi sono muri di blocchi): servono anche a quantizzare le posizioni in rete
+    static constexpr float Width = 800.f;
+    static constexpr float Height = 600.f;
+
+    // Aggiunge alla scena piattaforme, bordi ed effetti ambientali in loop
+    static void build(Scene& scene);
+
+    // Punti di spawn possibili (sulle piattaforme)
+    static const std::vector<SpawnPoint>& getEnemySpawnPoints();
+
+    // Spawna (dal pool della scena) i nemici del livello, controllati localmente,
+    // e se connessi li annuncia ai client. Ritorna quanti nemici ha creato.
+    static int spawnEnemies(Scene& scene, int level);
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+// Raccoglie gli overlay del mondo (health bar, hitbox di debug) in un unico
+// vertex array non texturato: una sola draw call per frame, qualunque sia il numero di entità.
+// Il vertex array viene riusato fra un frame e l'altro (nessuna allocazione a regime).
+class OverlayRenderer
+{
+private:
+    sf::VertexArray vertices;
+
+    void addQuad(float left, float top, float width, float height, const sf::Color& color);
+
+public:
+    OverlayRenderer();
+
+    void clear();
+    // Rettangolo pieno con bordo esterno (come sf::RectangleShape con outline positivo)
+    void addRect(const sf::FloatRect& rect, const sf::Color& fill,
+                 const sf::Color& outline = sf::Color::Transparent, float outlineThickness = 0.f);
+    // Barra della vita centrata in orizzontale su 'anchor' (posizione dello sprite), sopra la testa
+    void addHealthBar(const sf::Vector2f& anchor, float healthPercent);
+    void draw(sf::RenderTarget& target) const;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstdint>
+
+struct AtlasFrame;
+struct EffectQuad;
+
+// Tipi di effetto, con i frame presi da assets/pp1/miscellaneous
+enum class EffectType : uint8_t
+{
+    HitSpark,   // effect_1..5, quando un Hittable subisce danno
+    DeathPuff,  // effect_3..5 sparsi verso l'esterno, alla morte
+    Lava,       // Lava1-3, in loop
+    Portal,     // Portal1-4, in loop
+    Count
+};
+
+// Sistema di particelle/effetti a capacità fissa.
+// Le particelle vivono in array SoA preallocati: [0, activeCount) sono vive e
+// update() le aggiorna in un'unica passata, rimuovendo le scadute con swap-remove.
+// Il render riceve i quad dallo snapshot e li accoda in uno SpriteBatch (un vertex array
+// per texture): i frame stanno nell'atlas dei personaggi, quindi costano una sola draw call.
+// Se la capacità è esaurita i nuovi effetti vengono scartati: nessuna allocazione in gioco.
+class ParticleSystem
+{
+    //Implements the singleton pattern
+    private:
+        static ParticleSystem* instance;
+
+        static constexpr std::size_t Capacity = 1024;
+
+        struct EffectClip
+        {
+            std::vector<const AtlasFrame*> frames;
+            sf::IntRect crop;       // parte visibile del frame 96x54
+            float frameDuration;
+            bool loop;
+        };
+        EffectClip clips[static_cast<int>(EffectType::Count)];
+        bool assetsLoaded;
+
+        // SoA
+        std::vector<float> posX, posY;
+        std::vector<float> velX, velY;
+        std::vector<float> age, lifetime; // lifetime < 0: effetto in loop, non scade mai (age < durata clip)
+        std::vector<float> gravity;
+        std::vector<uint8_t> type;
+        std::size_t activeCount;
+        bool enabled;
+
+        ParticleSystem();
+        void loadAssets();
+        bool spawn(EffectType effect, float x, float y, float vx, float vy, float g, float life);
+
+    public:
+        static ParticleSystem* getInstance();
+        static void destroyInstance();
+
+        // Effetto istantaneo (scintilla, sbuffo di morte) centrato su 'position'
+        void emit(EffectType effect, const sf::Vector2f& position);
+        // Effetto ambientale in loop (lava, portali), resta fino a clear()
+        void addLoop(EffectType effect, const sf::Vector2f& position);
+
+        void update(float dt);
+        // Accoda in 'out' un quad per ogni particella viva (per il RenderSnapshot)
+        void capture(std::vector<EffectQuad>& out) const;
+        void clear();
+        // Disattivato (headless) emit/addLoop/update non fanno nulla: gli effetti sono solo grafica
+        void setEnabled(bool value);
+
+        std::size_t getActiveCount() const { return activeCount; }
+};
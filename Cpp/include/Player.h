@@ -4,76 +4,93 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <vector>
 #include <string>
+#include <functional>
 #include "Hittable.h"
+#include "NetCompact.h"
 
 class Block;
 class Scene;
+class Kinematics;
+class Animator;
+class NetworkClient;
+struct CharacterClips;
+struct ActorSnapshot;
+
+// Comandi del player locale in un tick (tastiera, oppure uno script per i bot headless)
+struct PlayerInput
+{
+    bool left = false;
+    bool right = false;
+    bool jump = false;
+    bool attack = false;
+};
 
 class Player: public Hittable
 {
     private:
-        //no point in saving x and y
-        //Sprite holds 
+        //posizione, velocità e collider stanno nel sistema Kinematics della scena:
+        //qui teniamo solo l'indice del nostro body
+        Kinematics& kinematics;
+        uint32_t body;
         sf::Sprite sprite;
-        sf::Vector2f velocity;
         
-        std::vector<sf::Texture> walk_textures;
-        sf::Texture idle_texture;
-        std::vector<sf::Texture> jump_textures;
-        sf::Texture falling_texture;
-        std::vector<sf::Texture> attack_textures;
-
-        //we need to add a rectangle for the player collisions
-        float colliderOffsetX;
-        float colliderOffsetY;
-        sf::FloatRect collider;
-
-        int current_animation_frame;
-        float animation_timer, animation_speed;
+        // Clip condivise fra tutti i player (AnimationLibrary); la riproduzione sta nell'Animator
+        Animator& animations;
+        uint32_t animator;
+        const CharacterClips* clips;
+        
+        // Connessione su cui il player locale invia movimenti, attacchi e danni
+        NetworkClient& network;
+        // Se impostata sostituisce tastiera e mouse (bot)
+        std::function<PlayerInput()> inputSource;
+        // Baseline dei MOVE_COMPACT: l'ultimo stato spedito (vedi NetCompact.h)
+        QuantizedState sentMove;
+        bool hasSentMove;
+        uint32_t moveEpoch;          // epoch delle capacità a cui si riferisce la baseline
+        uint32_t movesSinceKeyframe;
+        std::vector<uint8_t> moveBuffer;
         
-        bool isGrounded;
-        float speed, gravity;
+        float speed;
         bool facingRight;
         bool localPlayer;
         
         // Attack animation state
         bool isAttacking;
-        size_t attackFrame;
-        float attackTimer;
-        static constexpr float attackFrameDuration = 0.1f;
         sf::FloatRect attackHitbox; // For debug drawing
         float attackCooldownTimer;
         static constexpr float attackCooldown = 0.5f; // Cooldown in seconds
-        
-        // Animation cache (per-player, not static)
-        sf::Texture* lastTexture;
-        bool lastFacingRight;
 
         std::string playerName;
         std::string folder;
         int id; // max 255 giocatori
 
         void handle_input(const Scene& scene);
-        void apply_gravity(float dt);
-        void moveX(float dt, const std::vector<Block*>& blocks);
-        void moveY(float dt, const std::vector<Block*>& blocks);
-        void updateAnimation(float dt);
-        void updateCollider();
+        static PlayerInput readKeyboard();
+        void updateAnimation();
+        void applyDeathFade();
         void attack(const Scene& scene);
         void setAttackAnimation();
+        void sendMove(const sf::Vector2f& position);
     public:
-        Player(std::string texturePathFolder, std::string playerName, bool localPlayer);
+        Player(Kinematics& kinematics, Animator& animations, NetworkClient& network,
+               std::string texturePathFolder, std::string playerName, bool localPlayer);
+        ~Player() override;
         void update(const Scene& scene) override;
-        void draw(sf::RenderWindow &window) override;
+        void lateUpdate(const Scene& scene) override;
+        void captureRender(ActorSnapshot& out);
         void syncFromNetwork(float x, float y, float velX, float velY, bool faceRight, bool grounded);
         void respawn(); // Respawn del player locale
+        // Posizione iniziale (senza interpolare dal punto di spawn di default)
+        void setInitialPosition(float x, float y);
+        void setInputSource(std::function<PlayerInput()> source); // Input scriptato al posto della tastiera
         void triggerAttackAnimation(); // Attiva animazione attacco (per sync rete)
         void takeDamage(float amount) override; // Override per sync rete
         void syncDamageFromNetwork(float damage, float health); // Riceve danno dalla rete (player remoti)
         void applyDamageFromHost(float damage); // Riceve danno dall'host (player locale)
         int getId() const;
         void setId(int newId);
-        sf::FloatRect getBounds() const { return collider; }
+        sf::FloatRect getBounds() const;
+        sf::Vector2f getPosition() const override;
 
         enum class PlayerState
         {
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "TileLayer.h"
+
+// Stato mostrato dall'HUD (Game::drawHud): i testi si ricostruiscono solo se cambia
+struct HudState
+{
+    int enemiesToDefeat = 0;
+    int level = 0;
+    bool isHost = false;
+    bool gameOver = false;
+    bool gameWon = false;
+
+    bool operator==(const HudState& other) const
+    {
+        return enemiesToDefeat == other.enemiesToDefeat && level == other.level &&
+               isHost == other.isHost && gameOver == other.gameOver && gameWon == other.gameWon;
+    }
+    bool operator!=(const HudState& other) const { return !(*this == other); }
+};
+
+// Un attore come va disegnato: sprite agli ultimi due tick più i dati dell'overlay
+struct ActorSnapshot
+{
+    const sf::Texture* texture = nullptr;
+    sf::IntRect textureRect;
+    sf::Vector2f origin;
+    sf::Vector2f previousPosition; // tick precedente, per l'interpolazione
+    sf::Vector2f position;
+    float scaleX = 1.f;            // -1 se guarda a sinistra
+    float rotation = 0.f;
+    sf::Color color = sf::Color::White;
+
+    float healthPercent = 1.f;
+    bool showHealthBar = true;
+    bool showHitbox = false;
+    sf::FloatRect hitbox;
+};
+
+// Un quad texturato degli effetti (ParticleSystem), già in coordinate mondo
+struct EffectQuad
+{
+    const sf::Texture* texture = nullptr;
+    sf::FloatRect bounds;
+    sf::IntRect rect;
+    sf::Color color = sf::Color::White;
+};
+
+// Fotografia immutabile di tutto ciò che serve a disegnare un frame.
+// La scrive la simulazione (Scene::captureSnapshot) e la legge solo il render
+// (SceneRenderer): in modalità threaded passa fra i due thread in un TripleBuffer,
+// senza che il render tocchi mai entità, fisica o rete.
+// I vector vengono svuotati e riempiti ad ogni cattura: la memoria si riusa.
+struct RenderSnapshot
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Mappa statica: condivisa fra gli snapshot, cambia solo se cambiano i blocchi
+    std::shared_ptr<const std::vector<StaticTile>> tiles;
+
+    std::vector<ActorSnapshot> actors; // prima i nemici, poi i player (in primo piano)
+    int cameraTarget = -1;             // indice in 'actors' del player locale, -1 se assente
+    std::vector<EffectQuad> effects;
+    HudState hud;
+
+    // Interpolazione: frazione di tick già trascorsa alla cattura e durata di un tick
+    float alpha = 1.f;
+    float tickDuration = 1.f / 60.f;
+    Clock::time_point capturedAt;
+
+    // Frazione di tick da usare per disegnare all'istante 'now' (in [0,1])
+    float alphaAt(Clock::time_point now) const
+    {
+        float elapsed = std::chrono::duration<float>(now - capturedAt).count();
+        return std::min(1.f, alpha + elapsed / tickDuration);
+    }
+};
@@ -2,40 +2,193 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 #include "GameObject.h"
+#include "SpatialGrid.h"
+#include "SweepAndPrune.h"
+#include "Kinematics.h"
+#include "Animator.h"
+#include "SceneRenderer.h"
+#include "RenderSnapshot.h"
+#include "NetCompact.h"
 
 class Block;
 class Player;
 class Enemy;
+class NetworkClient;
+struct EnemyNetState;
 
 class Scene
 {
 private:
+    // Connessione da cui arrivano i pacchetti (e da cui gli attori inviano i loro)
+    NetworkClient& network;
+
+    // Dichiarati prima di 'entities': gli attori restituiscono body e animator nel distruttore
+    Kinematics kinematics;
+    Animator animations;
     std::vector<std::unique_ptr<GameObject>> entities;
+
+    // Tabella degli slot per gli EntityHandle: la generazione avanza ad ogni rimozione
+    struct EntitySlot
+    {
+        GameObject* entity = nullptr;
+        uint32_t generation = 0;
+        bool despawning = false;
+    };
+    std::vector<EntitySlot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    // Command buffer: spawn e despawn richiesti durante il frame vengono applicati
+    // tutti insieme in flushCommands(), così 'entities' e le viste tipizzate non
+    // cambiano mentre qualcuno le sta iterando
+    std::vector<std::unique_ptr<GameObject>> spawnQueue;
+    std::vector<GameObject*> despawnQueue;
+    std::vector<uint32_t> releasedSlots; // buffer riutilizzato da applyDespawns
+    EntityHandle localPlayerHandle;
+
+    // Nemici rimossi dalla scena, pronti per essere riusati da spawnEnemy()
+    // (texture già caricate, body già allocato)
+    std::vector<std::unique_ptr<Enemy>> enemyPool;
+
+    // Viste tipizzate sulle entità: aggiornate quando si aggiungono/rimuovono entità,
+    // così le query non fanno dynamic_cast né allocazioni ad ogni chiamata
+    std::vector<Block*> blocks;
+    std::vector<Player*> players;
+    std::vector<Enemy*> enemies;
+    std::vector<GameObject*> others;
+
+    // Indici ID di rete -> entità, per gestire i pacchetti in O(1)
+    std::unordered_map<uint32_t, Player*> playersById;
+    std::unordered_map<uint32_t, Enemy*> enemiesById;
+
+    // Mappa per il render, condivisa da tutti gli snapshot: ricreata solo se i blocchi cambiano
+    std::shared_ptr<const std::vector<StaticTile>> staticTiles;
+    bool tilesDirty;
+
+    // Render sullo stesso thread (draw): cattura lo snapshot e lo disegna subito.
+    // In modalità threaded il main usa captureSnapshot() e un SceneRenderer proprio.
+    SceneRenderer renderer;
+    RenderSnapshot frameSnapshot;
+
+    // Collisioni "cotte": i blocchi adiacenti fusi in pochi rettangoli solidi.
+    // Ricalcolate (lazy) all'inizio di update() quando l'insieme dei blocchi cambia.
+    std::vector<sf::FloatRect> solidRects;
+    SpatialGrid solidGrid;
+    bool collisionDirty;
+    mutable std::vector<uint32_t> gridQueryIndices;
+    mutable std::vector<sf::FloatRect> solidQueryResult;
+
+    // Broadphase degli attori (player e nemici), aggiornata una volta per tick.
+    // actorSetVersion cambia ad ogni aggiunta/rimozione di attori.
+    SweepAndPrune<Player> playerBroadphase;
+    SweepAndPrune<Enemy> enemyBroadphase;
+    uint64_t actorSetVersion;
+    mutable std::vector<Player*> playerQueryResult;
+    mutable std::vector<Enemy*> enemyQueryResult;
+
+    // Tick di rete: lo stato dei nemici (host) parte a questa frequenza, non ad ogni tick
+    float netTickInterval;  // 0 = ad ogni tick di simulazione
+    float netTickTimer;
+    uint32_t netTick;
+    std::vector<char> snapshotBuffer; // riusato da sendEnemySnapshots()
+
+    // Stato compatto (NetCompact.h): baseline per entità dei delta spediti e ricevuti.
+    // TCP è ordinato, quindi l'ultimo stato spedito è anche l'ultimo ricevuto dall'altra parte.
+    std::unordered_map<uint32_t, QuantizedState> sentEnemyStates;
+    std::unordered_map<uint32_t, QuantizedState> receivedEnemyStates;
+    std::unordered_map<uint32_t, QuantizedState> receivedPlayerStates;
+    uint32_t compactEpoch;            // epoch delle capacità a cui si riferiscono le baseline spedite
+    uint32_t ticksSinceKeyframe;
+    std::vector<uint8_t> compactBuffer; // riusato da sendCompactEnemySnapshots()
+
     float dt;
-    int localPlayerId;
+    float renderAlpha; // frazione di tick trascorsa, per interpolare le posizioni al draw
+    int localPlayerId; // -1 finché il server non ci assegna un ID (LOGIN)
     bool isHost;  // True se siamo l'host
 
 public:
-    Scene();
+    explicit Scene(NetworkClient& network);
+    ~Scene(); // definito nel .cpp: il pool contiene unique_ptr<Enemy> (tipo incompleto qui)
+
+    const std::vector<Block*>& getBlocks() const { return blocks; }
+    const std::vector<Player*>& getPlayers() const { return players; }
+    const std::vector<Enemy*>& getEnemies() const { return enemies; }
+    const std::vector<GameObject*>& getOthers() const { return others; }
 
-    std::vector<Block*> getBlocks() const;
-    std::vector<Player*> getPlayers() const;
-    std::vector<Enemy*> getEnemies() const;
+    // Ricerca per ID di rete; nullptr se non presente
+    Player* findPlayer(uint32_t playerId) const;
+    Enemy* findEnemy(uint32_t enemyId) const;
+    void changePlayerId(Player* player, uint32_t newId);
+
+    // Rettangoli solidi (fusi) che intersecano 'area': è quello che usa la fisica.
+    // Il vettore ritornato resta valido fino alla prossima chiamata.
+    const std::vector<sf::FloatRect>& querySolids(const sf::FloatRect& area) const;
+    const std::vector<sf::FloatRect>& getSolidRects() const { return solidRects; }
+
+    // Player/nemici candidati vicino ad 'area' (hitbox d'attacco, raggio di visione AI).
+    // Sono candidati "larghi": il chiamante fa il test esatto. Validi fino alla prossima chiamata.
+    const std::vector<Player*>& queryPlayers(const sf::FloatRect& area) const;
+    const std::vector<Enemy*>& queryEnemies(const sf::FloatRect& area) const;
+    // Stato fisico (SoA) di player e nemici: posizione, velocità, collider
+    Kinematics& getKinematics() { return kinematics; }
+    const Kinematics& getKinematics() const { return kinematics; }
+    // Stato di riproduzione delle animazioni di player e nemici
+    Animator& getAnimator() { return animations; }
+    NetworkClient& getNetwork() { return network; }
     void setDt(float dt);
+    void setRenderAlpha(float alpha) { renderAlpha = alpha; }
+    const Camera& getCamera() const { return renderer.getCamera(); }
+    // Pre-render della mappa in RenderTexture (un quad per chunk invece dei vertex array)
+    void setStaticLayerCache(bool enabled) { renderer.setStaticLayerCache(enabled); }
     float getDt() const;
-    void addEntity(std::unique_ptr<GameObject> entity);
+    // Frequenza (Hz) degli snapshot dei nemici inviati dall'host; 0 = ad ogni tick
+    void setNetTickRate(float hz);
+    // Accoda lo spawn: l'entità entra in 'entities' (update/draw/query) al prossimo flushCommands().
+    // Gli indici per ID di rete sono aggiornati subito, così i pacchetti successivi la trovano.
+    EntityHandle addEntity(std::unique_ptr<GameObject> entity);
+    // Accoda la rimozione; l'entità viene distrutta al prossimo flushCommands()
+    void removeEntity(EntityHandle handle);
+    // nullptr se l'handle è nullo o l'entità è già stata distrutta
+    GameObject* getEntity(EntityHandle handle) const;
+    // Applica in blocco gli spawn e i despawn accodati (chiamata anche da update())
+    void flushCommands();
     void update();
-    void draw(sf::RenderWindow& window) const;
+    // Copia in 'out' tutto ciò che serve a disegnare il frame (attori, effetti, HUD, mappa).
+    // alpha: frazione di tick già trascorsa al momento della cattura
+    void captureSnapshot(RenderSnapshot& out, float alpha);
+    // Render sul thread corrente: captureSnapshot() + SceneRenderer::draw()
+    void draw(sf::RenderWindow& window);
     Player* getLocalPlayerInScene();
 
     void setLocalPlayerId(int id) { localPlayerId = id; }
     int getLocalPlayerId() const { return localPlayerId; }
     void setIsHost(bool host) { isHost = host; }
     bool getIsHost() const { return isHost; }
-    void addRemotePlayer(int id);
+    // Il player appare subito in (x, y): il primo frame non interpola dallo spawn di default
+    Player* addRemotePlayer(int id, float x, float y);
+    // Spawn di un nemico riusando un'istanza del pool (ne crea una nuova solo se il pool è vuoto)
+    Enemy* spawnEnemy(uint32_t id, bool localControl, float x, float y);
+    // Crea in anticipo le istanze del pool, così i cambi livello non caricano texture
+    void prewarmEnemies(std::size_t count);
     void removePlayer(uint32_t playerId);  // Rimuove un player dalla scena
+    // Rimozione immediata, fuori da update(); dentro update() si usa despawnAllEnemies()
     void removeAllEnemies();
     void respawnLocalPlayer();
+
+private:
+    void registerEntity(GameObject* entity);
+    void rebuildCollision();
+    void despawnEntity(GameObject* entity);
+    bool isDespawning(const GameObject* entity) const;
+    void applyDespawns();
+    void despawnAllEnemies();
+    void unindexPlayer(Player* player);
+    void unindexEnemy(Enemy* enemy);
+    void sendEnemySnapshots();
+    void sendCompactEnemySnapshots();
+    void applyEnemyState(const EnemyNetState& state);
+    void applyPlayerMove(uint32_t playerId, float x, float y, float velocityX, float velocityY,
+                         bool facingRight, bool grounded);
 };
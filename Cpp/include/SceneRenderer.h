@@ -0,0 +1,41 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+#include "TileLayer.h"
+#include "SpriteBatch.h"
+#include "OverlayRenderer.h"
+#include "Camera.h"
+
+struct RenderSnapshot;
+
+// Disegna un RenderSnapshot: mappa (TileLayer), attori in batch, effetti e overlay,
+// con la telecamera che segue il player locale. Non conosce Scene né le entità,
+// quindi può girare su un thread dedicato mentre la simulazione prosegue.
+// Tutte le risorse grafiche (vertex array, cache dei chunk) vivono qui: va usato
+// solo dal thread che possiede il contesto OpenGL della finestra.
+class SceneRenderer
+{
+private:
+    TileLayer tileLayer;
+    // Mappa da cui è stato costruito tileLayer: si ricostruisce quando lo snapshot ne porta una nuova
+    std::shared_ptr<const std::vector<StaticTile>> currentTiles;
+
+    SpriteBatch batch;           // attori, poi effetti
+    OverlayRenderer overlay;     // health bar e hitbox
+    Camera camera;
+
+    sf::Sprite scratchSprite;               // riusato per accodare gli attori nel batch
+    std::vector<std::size_t> visibleActors; // indici degli attori nell'area visibile
+    std::vector<sf::Vector2f> renderPositions;
+
+public:
+    void setStaticLayerCache(bool enabled) { tileLayer.setCacheEnabled(enabled); }
+
+    // alpha in [0,1]: posizione fra il tick precedente e quello catturato
+    void draw(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha);
+
+    const Camera& getCamera() const { return camera; }
+};
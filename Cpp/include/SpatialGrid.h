@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+
+// Griglia uniforme per geometria statica (blocchi).
+// Ogni elemento viene registrato in tutte le celle che il suo AABB tocca;
+// una query visita solo le celle coperte dall'area richiesta, quindi il costo
+// dipende da quanti elementi ci sono vicino, non dalla dimensione della mappa.
+class SpatialGrid
+{
+private:
+    float cellSize;
+    std::unordered_map<int64_t, std::vector<uint32_t>> cells; // sparsa: solo le celle occupate
+    std::vector<sf::FloatRect> bounds;
+
+    // Evita di restituire due volte un elemento che occupa più celle
+    mutable std::vector<uint32_t> lastSeen;
+    mutable uint32_t queryStamp;
+
+    static int64_t cellKey(int cx, int cy);
+    int toCell(float coord) const;
+
+public:
+    explicit SpatialGrid(float cellSize = 64.f);
+
+    void clear();
+
+    // Registra un AABB e ritorna il suo indice (0, 1, 2... in ordine di inserimento)
+    uint32_t insert(const sf::FloatRect& itemBounds);
+
+    // Scrive in 'out' gli indici degli elementi che intersecano 'area'
+    void query(const sf::FloatRect& area, std::vector<uint32_t>& out) const;
+
+    const sf::FloatRect& getBounds(uint32_t index) const { return bounds[index]; }
+    std::size_t size() const { return bounds.size(); }
+    float getCellSize() const { return cellSize; }
+};
+
+// AABB che contiene entrambi i rettangoli (es. collider prima e dopo lo spostamento)
+inline sf::FloatRect unionRect(const sf::FloatRect& a, const sf::FloatRect& b)
+{
+    float left = std::min(a.left, b.left);
+    float top = std::min(a.top, b.top);
+    float right = std::max(a.left + a.width, b.left + b.width);
+    float bottom = std::max(a.top + a.height, b.top + b.height);
+    return sf::FloatRect(left, top, right - left, bottom - top);
+}
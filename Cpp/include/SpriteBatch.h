@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Raccoglie gli sprite di un frame e li disegna con un vertex array (quads) per texture.
+// Con l'atlas dei personaggi tutti gli attori stanno su poche texture,
+// quindi centinaia di sprite costano poche draw call.
+// I vertex array vengono riusati fra un frame e l'altro (nessuna allocazione a regime).
+class SpriteBatch
+{
+private:
+    struct Batch
+    {
+        const sf::Texture* texture;
+        sf::VertexArray vertices;
+    };
+    std::vector<Batch> batches;
+    std::size_t activeBatches = 0;
+
+    sf::VertexArray& verticesFor(const sf::Texture* texture);
+
+public:
+    // Svuota il batch mantenendo la memoria già allocata
+    void clear();
+    // Accoda lo sprite (trasformazione, ritaglio e colore inclusi)
+    void add(const sf::Sprite& sprite);
+    // Accoda un quad allineato agli assi (particelle, effetti): 'bounds' in coordinate mondo
+    void add(const sf::Texture* texture, const sf::FloatRect& bounds, const sf::IntRect& rect, const sf::Color& color);
+    void draw(sf::RenderTarget& target) const;
+
+    std::size_t getDrawCallCount() const { return activeBatches; }
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+// Broadphase "sweep and prune" sull'asse X per attori in movimento.
+// Gli AABB vengono aggiornati una volta per tick e allargati di 'looseMargin',
+// così restano validi anche se l'attore si muove durante il tick: chi usa le query
+// deve comunque fare il test esatto sui bounds correnti.
+// T deve esporre getBounds() -> sf::FloatRect.
+template <typename T>
+class SweepAndPrune
+{
+private:
+    struct Entry
+    {
+        float minX, maxX, minY, maxY;
+        T* actor;
+    };
+
+    std::vector<Entry> entries; // ordinate per minX
+    float maxWidth;             // larghezza massima: delimita l'inizio della scansione
+    float looseMargin;
+    uint64_t builtVersion;
+    bool built;
+
+    void refresh(Entry& entry) const
+    {
+        sf::FloatRect b = entry.actor->getBounds();
+        entry.minX = b.left - looseMargin;
+        entry.maxX = b.left + b.width + looseMargin;
+        entry.minY = b.top - looseMargin;
+        entry.maxY = b.top + b.height + looseMargin;
+    }
+
+    static bool lessMinX(const Entry& a, const Entry& b) { return a.minX < b.minX; }
+
+public:
+    explicit SweepAndPrune(float looseMargin = 16.f)
+        : maxWidth(0.f), looseMargin(looseMargin), builtVersion(0), built(false) {}
+
+    // 'version' cambia quando cambia l'insieme degli attori: in quel caso si riparte da zero,
+    // altrimenti si aggiornano i bounds e si riordina con insertion sort (l'ordine del tick
+    // precedente è quasi sempre già corretto).
+    void update(const std::vector<T*>& actors, uint64_t version)
+    {
+        if (!built || version != builtVersion || entries.size() != actors.size())
+        {
+            entries.clear();
+            for (T* actor : actors)
+            {
+                entries.push_back(Entry{ 0.f, 0.f, 0.f, 0.f, actor });
+            }
+            for (Entry& entry : entries) refresh(entry);
+            std::sort(entries.begin(), entries.end(), lessMinX);
+            builtVersion = version;
+            built = true;
+        }
+        else
+        {
+            for (Entry& entry : entries) refresh(entry);
+            for (std::size_t i = 1; i < entries.size(); i++)
+            {
+                Entry key = entries[i];
+                std::size_t j = i;
+                while (j > 0 && entries[j - 1].minX > key.minX)
+                {
+                    entries[j] = entries[j - 1];
+                    j--;
+                }
+                entries[j] = key;
+            }
+        }
+
+        maxWidth = 0.f;
+        for (const Entry& entry : entries)
+        {
+            maxWidth = std::max(maxWidth, entry.maxX - entry.minX);
+        }
+    }
+
+    // Candidati il cui AABB (allargato) interseca 'area'
+    void query(const sf::FloatRect& area, std::vector<T*>& out) const
+    {
+        out.clear();
+        float areaRight = area.left + area.width;
+        float areaBottom = area.top + area.height;
+
+        // Nessuna entry con minX < area.left - maxWidth può arrivare fino ad area.left
+        Entry probe{ area.left - maxWidth, 0.f, 0.f, 0.f, nullptr };
+        auto it = std::lower_bound(entries.begin(), entries.end(), probe, lessMinX);
+
+        for (; it != entries.end() && it->minX < areaRight; ++it)
+        {
+            if (it->maxX <= area.left) continue;
+            if (it->maxY <= area.top || it->minY >= areaBottom) continue;
+            out.push_back(it->actor);
+        }
+    }
+
+    void clear()
+    {
+        entries.clear();
+        built = false;
+    }
+};
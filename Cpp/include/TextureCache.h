@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Cache globale delle texture, indicizzata per percorso.
+// Ogni file viene decodificato e caricato sulla GPU una volta sola: Block, Player ed
+// Enemy condividono la stessa sf::Texture (immutabile) tramite shared_ptr.
+// La cache tiene solo weak_ptr, quindi una texture viene liberata quando
+// l'ultima entità che la usa viene distrutta.
+class TextureCache
+{
+    //Implements the singleton pattern
+    private:
+        static TextureCache* instance;
+        std::unordered_map<std::string, std::weak_ptr<const sf::Texture>> textures;
+        std::unordered_map<std::string, sf::Vector2u> imageSizes; // restano anche dopo che la texture è liberata
+        bool headless = false;
+        TextureCache() = default;
+
+    public:
+        static TextureCache* getInstance();
+        static void destroyInstance();
+
+        // Ritorna la texture già in memoria oppure la carica da disco.
+        // Se il caricamento fallisce ritorna comunque una texture vuota (ed errore su cerr).
+        std::shared_ptr<const sf::Texture> load(const std::string& path);
+
+        // Dimensioni dell'immagine in 'path': dalla texture se è già caricata, altrimenti dal file
+        // decodificato in un sf::Image (mai un upload sulla GPU). Il risultato resta in cache.
+        sf::Vector2u getImageSize(const std::string& path);
+
+        // Headless (bot, server dedicato): nessun contesto OpenGL, load() ritorna texture vuote
+        // e si leggono da disco solo le dimensioni delle immagini (servono per i collider)
+        void setHeadless(bool enabled) { headless = enabled; }
+        bool isHeadless() const { return headless; }
+
+        // Numero di texture attualmente in uso
+        std::size_t getLoadedCount() const;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+
+// Un blocco della mappa come lo vede il renderer: texture, rettangolo nel mondo e ritaglio
+struct StaticTile
+{
+    const sf::Texture* texture;
+    sf::FloatRect bounds;
+    sf::IntRect textureRect;
+};
+
+// Renderer della mappa statica: tutti i blocchi che condividono una texture
+// finiscono in un unico sf::VertexArray (quads), disegnato con una sola draw call.
+// La mappa è divisa in chunk quadrati: si disegnano solo quelli che intersecano
+// l'area visibile, quindi il costo non cresce con la dimensione del livello.
+//
+// Opzionalmente (setCacheEnabled) ogni chunk viene pre-renderizzato una volta in una
+// sf::RenderTexture: a regime un chunk costa un solo quad texturato, qualunque sia
+// il numero di blocchi e di texture. La cache si ricostruisce solo dopo rebuild().
+class TileLayer
+{
+private:
+    static constexpr float ChunkSize = 512.f;
+
+    struct Batch
+    {
+        const sf::Texture* texture;
+        sf::VertexArray vertices;
+    };
+    struct Chunk
+    {
+        int cx, cy;
+        sf::FloatRect bounds; // AABB reale dei blocchi contenuti
+        std::vector<Batch> batches;
+
+        // Cache off-screen del chunk (nullptr se disattivata o non disponibile)
+        std::unique_ptr<sf::RenderTexture> cache;
+        sf::Sprite cacheSprite;
+    };
+    std::vector<Chunk> chunks;
+    sf::FloatRect bounds; // AABB di tutta la mappa
+
+    bool cacheEnabled = false;
+    bool cacheDirty = false;
+
+    void renderCache(Chunk& chunk);
+
+    Chunk& chunkFor(int cx, int cy);
+    static Batch& batchFor(Chunk& chunk, const sf::Texture* texture);
+
+public:
+    // Ricostruisce i vertex array da zero: da chiamare solo quando l'insieme dei blocchi cambia
+    void rebuild(const std::vector<StaticTile>& tiles);
+    // Prepara le cache dei chunk se servono (richiede il contesto OpenGL: chiamare dal thread di render)
+    void updateCache();
+    // Disegna solo i chunk che intersecano 'visibleArea'
+    void draw(sf::RenderTarget& target, const sf::FloatRect& visibleArea) const;
+
+    void setCacheEnabled(bool enabled);
+    bool isCacheEnabled() const { return cacheEnabled; }
+
+    sf::FloatRect getBounds() const { return bounds; }
+    std::size_t getChunkCount() const { return chunks.size(); }
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Triplo buffer senza lock fra un solo produttore e un solo consumatore.
+// Il produttore scrive sempre nel proprio buffer e lo pubblica con publish();
+// il consumatore prende l'ultimo pubblicato con acquireLatest(). Nessuno dei due
+// aspetta l'altro: i valori intermedi che il consumatore non fa in tempo a leggere
+// vengono semplicemente sovrascritti.
+template <typename T>
+class TripleBuffer
+{
+private:
+    static constexpr uint8_t IndexMask = 0x3;
+    static constexpr uint8_t FreshBit = 0x4; // c'è un buffer pubblicato non ancora letto
+
+    T buffers[3];
+    // Indice del buffer "di mezzo" (l'ultimo pubblicato) + FreshBit
+    std::atomic<uint8_t> middle{ 0 };
+    uint8_t writeIndex = 1; // posseduto dal produttore
+    uint8_t readIndex = 2;  // posseduto dal consumatore
+
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Produttore: buffer da riempire (contiene dati vecchi, da sovrascrivere)
+    T& writeBuffer() { return buffers[writeIndex]; }
+
+    // Produttore: rende visibile il buffer appena scritto e ne prende uno libero
+    void publish()
+    {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(writeIndex | FreshBit), std::memory_order_acq_rel);
+        writeIndex = previous & IndexMask;
+    }
+
+    // Consumatore: se c'è un buffer nuovo lo scambia con quello in lettura e ritorna true
+    bool acquireLatest()
+    {
+        if ((middle.load(std::memory_order_acquire) & FreshBit) == 0)
+            return false;
+        uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & IndexMask;
+        return true;
+    }
+
+    // Consumatore: l'ultimo buffer acquisito (resta valido fino al prossimo acquireLatest)
+    const T& readBuffer() const { return buffers[readIndex]; }
+};
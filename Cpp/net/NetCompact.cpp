@@ -0,0 +1,193 @@
+#include "NetCompact.h"
+#include "Level.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Margine oltre i bordi della mappa (spawn, salti contro il soffitto)
+    constexpr float BoundsMargin = 100.f;
+    constexpr float MinX = -BoundsMargin;
+    constexpr float MinY = -BoundsMargin;
+    constexpr float RangeX = Level::Width + 2.f * BoundsMargin;
+    constexpr float RangeY = Level::Height + 2.f * BoundsMargin;
+    constexpr float VelocityScale = 16.f;
+
+    enum FieldMask : uint32_t
+    {
+        FIELD_X = 1 << 0,
+        FIELD_Y = 1 << 1,
+        FIELD_VELOCITY_X = 1 << 2,
+        FIELD_VELOCITY_Y = 1 << 3,
+        FIELD_FLAGS = 1 << 4,
+        FIELD_HEALTH = 1 << 5,
+        FIELD_COUNT = 6
+    };
+
+    constexpr unsigned FlagBits = 3;
+
+    uint16_t quantizePosition(float value, float min, float range)
+    {
+        float normalized = std::min(std::max((value - min) / range, 0.f), 1.f);
+        return static_cast<uint16_t>(std::lround(normalized * 65535.f));
+    }
+}
+
+QuantizedState quantizeState(float x, float y, float velocityX, float velocityY, uint8_t flags, float health)
+{
+    QuantizedState state;
+    state.x = quantizePosition(x, MinX, RangeX);
+    state.y = quantizePosition(y, MinY, RangeY);
+    state.velocityX = static_cast<int16_t>(std::lround(std::min(std::max(velocityX * VelocityScale, -32768.f), 32767.f)));
+    state.velocityY = static_cast<int16_t>(std::lround(std::min(std::max(velocityY * VelocityScale, -32768.f), 32767.f)));
+    state.flags = flags & ((1 << FlagBits) - 1);
+    // Un nemico ancora vivo non deve arrivare a 0 per l'arrotondamento
+    long roundedHealth = std::lround(std::min(std::max(health, 0.f), 255.f));
+    if (health > 0.f && roundedHealth == 0) roundedHealth = 1;
+    state.health = static_cast<uint8_t>(roundedHealth);
+    return state;
+}
+
+float dequantizeX(uint16_t x)
+{
+    return MinX + RangeX * (x / 65535.f);
+}
+
+float dequantizeY(uint16_t y)
+{
+    return MinY + RangeY * (y / 65535.f);
+}
+
+float dequantizeVelocity(int16_t velocity)
+{
+    return velocity / VelocityScale;
+}
+
+bool sameState(const QuantizedState& a, const QuantizedState& b, bool withHealth)
+{
+    return a.x == b.x && a.y == b.y && a.velocityX == b.velocityX && a.velocityY == b.velocityY &&
+           a.flags == b.flags && (!withHealth || a.health == b.health);
+}
+
+QuantizedState quantizeEnemyState(const EnemyNetState& state)
+{
+    uint8_t flags = (state.isFacingRight ? STATE_FACING_RIGHT : 0) |
+                    (state.isGrounded ? STATE_GROUNDED : 0) |
+                    (state.isAttacking ? STATE_ATTACKING : 0);
+    return quantizeState(state.x, state.y, state.velocityX, state.velocityY, flags, state.currentHealth);
+}
+
+EnemyNetState dequantizeEnemyState(uint32_t enemyId, const QuantizedState& state)
+{
+    EnemyNetState result;
+    result.enemyId = enemyId;
+    result.x = dequantizeX(state.x);
+    result.y = dequantizeY(state.y);
+    result.velocityX = dequantizeVelocity(state.velocityX);
+    result.velocityY = dequantizeVelocity(state.velocityY);
+    result.isFacingRight = (state.flags & STATE_FACING_RIGHT) ? 1 : 0;
+    result.isGrounded = (state.flags & STATE_GROUNDED) ? 1 : 0;
+    result.isAttacking = (state.flags & STATE_ATTACKING) ? 1 : 0;
+    result.padding = 0;
+    result.currentHealth = static_cast<float>(state.health);
+    return result;
+}
+
+BitWriter::BitWriter(std::vector<uint8_t>& out) : out(out), bitCount(out.size() * 8) {}
+
+void BitWriter::write(uint32_t value, unsigned bits)
+{
+    for (unsigned i = 0; i < bits; i++)
+    {
+        if (bitCount % 8 == 0)
+            out.push_back(0);
+        if (value & (1u << i))
+            out.back() |= static_cast<uint8_t>(1u << (bitCount % 8));
+        bitCount++;
+    }
+}
+
+BitReader::BitReader(const uint8_t* data, std::size_t size) : data(data), bitSize(size * 8), bitPos(0), overflow(false) {}
+
+uint32_t BitReader::read(unsigned bits)
+{
+    if (bitPos + bits > bitSize)
+    {
+        overflow = true;
+        bitPos = bitSize;
+        return 0;
+    }
+    uint32_t value = 0;
+    for (unsigned i = 0; i < bits; i++)
+    {
+        if (data[bitPos / 8] & (1u << (bitPos % 8)))
+            value |= 1u << i;
+        bitPos++;
+    }
+    return value;
+}
+
+void writeEntityId(BitWriter& writer, uint32_t id)
+{
+    bool small = id < 128;
+    writer.write(small ? 1 : 0, 1);
+    writer.write(id, small ? 7 : 32);
+}
+
+uint32_t readEntityId(BitReader& reader)
+{
+    bool small = reader.read(1) != 0;
+    return reader.read(small ? 7 : 32);
+}
+
+bool writeStateRecord(BitWriter& writer, const QuantizedState& state, const QuantizedState* baseline, bool withHealth)
+{
+    uint32_t mask = FIELD_X | FIELD_Y | FIELD_VELOCITY_X | FIELD_VELOCITY_Y | FIELD_FLAGS | (withHealth ? uint32_t(FIELD_HEALTH) : 0u);
+    if (baseline)
+    {
+        mask = 0;
+        if (state.x != baseline->x) mask |= FIELD_X;
+        if (state.y != baseline->y) mask |= FIELD_Y;
+        if (state.velocityX != baseline->velocityX) mask |= FIELD_VELOCITY_X;
+        if (state.velocityY != baseline->velocityY) mask |= FIELD_VELOCITY_Y;
+        if (state.flags != baseline->flags) mask |= FIELD_FLAGS;
+        if (withHealth && state.health != baseline->health) mask |= FIELD_HEALTH;
+        if (mask == 0) return false;
+
+        writer.write(0, 1);
+        writer.write(mask, FIELD_COUNT);
+    }
+    else
+    {
+        writer.write(1, 1);
+    }
+
+    if (mask & FIELD_X) writer.write(state.x, 16);
+    if (mask & FIELD_Y) writer.write(state.y, 16);
+    if (mask & FIELD_VELOCITY_X) writer.write(static_cast<uint16_t>(state.velocityX), 16);
+    if (mask & FIELD_VELOCITY_Y) writer.write(static_cast<uint16_t>(state.velocityY), 16);
+    if (mask & FIELD_FLAGS) writer.write(state.flags, FlagBits);
+    if (mask & FIELD_HEALTH) writer.write(state.health, 8);
+    return true;
+}
+
+bool readStateRecord(BitReader& reader, QuantizedState& state, const QuantizedState* baseline, bool withHealth)
+{
+    bool full = reader.read(1) != 0;
+    uint32_t mask = full
+        ? (FIELD_X | FIELD_Y | FIELD_VELOCITY_X | FIELD_VELOCITY_Y | FIELD_FLAGS | (withHealth ? uint32_t(FIELD_HEALTH) : 0u))
+        : reader.read(FIELD_COUNT);
+
+    QuantizedState result = baseline ? *baseline : QuantizedState();
+    if (mask & FIELD_X) result.x = static_cast<uint16_t>(reader.read(16));
+    if (mask & FIELD_Y) result.y = static_cast<uint16_t>(reader.read(16));
+    if (mask & FIELD_VELOCITY_X) result.velocityX = static_cast<int16_t>(reader.read(16));
+    if (mask & FIELD_VELOCITY_Y) result.velocityY = static_cast<int16_t>(reader.read(16));
+    if (mask & FIELD_FLAGS) result.flags = static_cast<uint8_t>(reader.read(FlagBits));
+    if (mask & FIELD_HEALTH) result.health = static_cast<uint8_t>(reader.read(8));
+
+    if (reader.failed() || (!full && !baseline)) return false;
+    state = result;
+    return true;
+}
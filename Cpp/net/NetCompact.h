@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "NetMessages.h"
+
+// Codifica compatta dello stato di player e nemici (MOVE_COMPACT, ENEMY_SNAPSHOT_COMPACT).
+// Posizioni in virgola fissa relative ai bordi del livello, velocità quantizzate, flag in bit;
+// per ogni entità si spediscono solo i campi cambiati rispetto all'ultimo stato inviato
+// (TCP consegna tutto in ordine: l'ultimo inviato è anche l'ultimo ricevuto dall'altra parte).
+
+// Ogni quanti stati si rispedisce un record completo anche se c'è una baseline
+// (chi è arrivato dopo o ha perso la baseline si riallinea)
+constexpr uint32_t MoveKeyframeInterval = 60;      // pacchetti MOVE (tick di simulazione)
+constexpr uint32_t SnapshotKeyframeInterval = 20;  // snapshot (tick di rete)
+// Dimensione massima di [id, record] (completo, ID a 32 bit): chi impacchetta tiene questo margine
+constexpr std::size_t MaxStateRecordBytes = 16;
+
+enum StateFlag : uint8_t
+{
+    STATE_FACING_RIGHT = 1 << 0,
+    STATE_GROUNDED = 1 << 1,
+    STATE_ATTACKING = 1 << 2
+};
+
+// Stato quantizzato: mittente e destinatario confrontano questi interi, non i float,
+// così le baseline dei due lati restano identiche
+struct QuantizedState
+{
+    uint16_t x = 0;          // posizione in 65536 passi sui bordi del livello (più un margine)
+    uint16_t y = 0;
+    int16_t velocityX = 0;   // 1/16 di pixel al secondo
+    int16_t velocityY = 0;
+    uint8_t flags = 0;       // StateFlag
+    uint8_t health = 0;      // salute arrotondata (solo nemici)
+};
+
+QuantizedState quantizeState(float x, float y, float velocityX, float velocityY, uint8_t flags, float health);
+float dequantizeX(uint16_t x);
+float dequantizeY(uint16_t y);
+float dequantizeVelocity(int16_t velocity);
+bool sameState(const QuantizedState& a, const QuantizedState& b, bool withHealth);
+
+// Conversioni da/verso lo stato non compresso dei nemici (ENEMY_SNAPSHOT)
+QuantizedState quantizeEnemyState(const EnemyNetState& state);
+EnemyNetState dequantizeEnemyState(uint32_t enemyId, const QuantizedState& state);
+
+// Scrive valori di lunghezza arbitraria (fino a 32 bit) uno di seguito all'altro
+class BitWriter
+{
+private:
+    std::vector<uint8_t>& out;
+    std::size_t bitCount;
+
+public:
+    explicit BitWriter(std::vector<uint8_t>& out);
+    void write(uint32_t value, unsigned bits);
+    // Riparte dalla fine attuale del vettore (dopo che il chiamante l'ha accorciato)
+    void restart() { bitCount = out.size() * 8; }
+    std::size_t byteSize() const { return (bitCount + 7) / 8; }
+};
+
+class BitReader
+{
+private:
+    const uint8_t* data;
+    std::size_t bitSize;
+    std::size_t bitPos;
+    bool overflow;
+
+public:
+    BitReader(const uint8_t* data, std::size_t size);
+    uint32_t read(unsigned bits); // 0 oltre la fine (e failed() diventa true)
+    bool failed() const { return overflow; }
+};
+
+// ID di un'entità: 1 bit + 7 bit se piccolo (i nemici), altrimenti 1 + 32
+void writeEntityId(BitWriter& writer, uint32_t id);
+uint32_t readEntityId(BitReader& reader);
+
+// Record di stato: [completo:1] [maschera dei campi:6 se delta] [campi presenti].
+// Senza baseline il record è completo. Ritorna false (senza scrivere nulla)
+// se è un delta vuoto: non c'è niente da spedire.
+bool writeStateRecord(BitWriter& writer, const QuantizedState& state, const QuantizedState* baseline, bool withHealth);
+
+// Legge un record applicandolo alla baseline. Un delta senza baseline viene consumato
+// (i record successivi restano leggibili) ma ritorna false: lo stato non è noto.
+bool readStateRecord(BitReader& reader, QuantizedState& state, const QuantizedState* baseline, bool withHealth);
@@ -13,7 +13,19 @@ enum PacketType : uint32_t
     ENEMY_DEATH = 7,      // Un nemico è morto
     PLAYER_ATTACK = 8,    // Un player sta attaccando
     HOST_ANNOUNCE = 9,    // Annuncio dell'host (chi controlla i nemici)
-    PLAYER_DAMAGE = 10    // Un player ha subito danno
+    PLAYER_DAMAGE = 10,   // Un player ha subito danno
+    PING = 11,            // Misura della latenza: il server lo rimanda solo al mittente
+    ENEMY_SNAPSHOT = 12,  // Stato di tutti i nemici dell'host, una volta per tick di rete
+    MOVE_COMPACT = 13,    // Come MOVE, quantizzato e delta (solo fra client che lo supportano)
+    ENEMY_SNAPSHOT_COMPACT = 14, // Come ENEMY_SNAPSHOT, quantizzato e delta
+    NET_CAPS = 15,        // Il server comunica le capacità comuni a tutti i client connessi
+    HELLO = 16            // Il client dichiara le sue capacità (consumato dal server, mai inoltrato)
+};
+
+// Capacità dichiarate dal client nell'HELLO
+enum NetCapability : uint32_t
+{
+    CAP_COMPACT_STATE = 1 << 0  // Sa leggere MOVE_COMPACT ed ENEMY_SNAPSHOT_COMPACT
 };
 
 // Disabilita il padding automatico del compilatore (fondamentale per comunicare con Go!)
@@ -48,6 +60,21 @@ struct PacketLogin
     uint32_t playerId; // Il server ti risponderà assegnandoti un ID
 };
 
+// Pacchetto giocatore disconnesso (inviato dal server)
+struct PacketPlayerDisconnected
+{
+    PacketHeader header;
+    uint32_t playerId; // Chi se n'è andato
+};
+
+// Hello del client, subito dopo la connessione.
+// I client che non lo mandano (versioni vecchie) non ricevono mai pacchetti compatti.
+struct PacketHello
+{
+    PacketHeader header;
+    uint32_t capabilities; // NetCapability supportate
+};
+
 // 4. Pacchetto Spawn Nemico
 struct PacketEnemySpawn
 {
@@ -117,4 +144,72 @@ struct PacketPlayerDamage
     float currentHealth;   // Salute attuale dopo il danno
 };
 
-#pragma pack(pop) // Riabilita il padding normale
\ No newline at end of file
+// 11. Pacchetto Ping (il server lo rimanda identico al mittente)
+struct PacketPing
+{
+    PacketHeader header;
+    uint32_t sequence;     // Numero progressivo del ping
+    uint32_t padding;      // Padding esplicito (sendTime allineato a 8 byte)
+    uint64_t sendTime;     // Microsecondi dall'avvio del client che l'ha inviato
+};
+
+// Stato di un nemico dentro uno snapshot (stessi campi di PacketEnemyUpdate, senza header)
+struct EnemyNetState
+{
+    uint32_t enemyId;
+    float x;
+    float y;
+    float velocityX;
+    float velocityY;
+    uint8_t isFacingRight;
+    uint8_t isGrounded;
+    uint8_t isAttacking;
+    uint8_t padding;
+    float currentHealth;
+};
+
+// 12. Pacchetto Snapshot Nemici (dimensione variabile)
+// Subito dopo questa intestazione ci sono 'count' EnemyNetState.
+// Se i nemici non stanno in un pacchetto, lo snapshot è spezzato in più pacchetti con lo stesso tick.
+struct PacketEnemySnapshot
+{
+    PacketHeader header;
+    uint32_t tick;         // Numero del tick di rete dell'host
+    uint16_t count;        // Quanti EnemyNetState seguono
+    uint16_t padding;
+};
+
+// 13. Pacchetto Movimento Compatto (dimensione variabile)
+// Dopo il playerId (in chiaro: il server lo sovrascrive come in MOVE) c'è un record
+// di stato codificato a bit (vedi NetCompact.h), fino a packetSize.
+struct PacketMoveCompact
+{
+    PacketHeader header;
+    uint32_t playerId;
+};
+
+// 14. Pacchetto Snapshot Nemici Compatto (dimensione variabile)
+// Seguono 'count' coppie [id, record] codificate a bit (vedi NetCompact.h).
+// I nemici che non sono cambiati dall'ultimo snapshot non ci sono.
+struct PacketEnemySnapshotCompact
+{
+    PacketHeader header;
+    uint32_t tick;
+    uint16_t count;
+    uint16_t padding;
+};
+
+// 15. Pacchetto Capacità (server -> client che hanno mandato l'hello)
+// Inviato ad ogni ingresso/uscita: i pacchetti compatti si usano solo se tutti li capiscono.
+// Un nuovo epoch azzera le baseline dei delta (il prossimo stato parte completo).
+struct PacketNetCaps
+{
+    PacketHeader header;
+    uint32_t capabilities; // Capacità comuni a tutti i client connessi
+    uint32_t epoch;
+};
+
+#pragma pack(pop) // Riabilita il padding normale
+
+// Massimo di nemici in un singolo pacchetto snapshot (limite di 1024 byte del server Go)
+constexpr uint32_t MaxEnemiesPerSnapshot = (1024 - sizeof(PacketEnemySnapshot)) / sizeof(EnemyNetState);
\ No newline at end of file
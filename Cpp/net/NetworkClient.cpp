@@ -1,15 +1,20 @@
 #include "NetworkClient.h"
 #include "NetMessages.h"
 
-#include "NetworkClient.h"
-
 #include <SFML/System.hpp>
+#include <cstring>
 
 // Inizializzazione membro statico
 NetworkClient* NetworkClient::instance = nullptr;
 
-NetworkClient::NetworkClient() : connected(false) 
+NetworkClient::NetworkClient() 
+    : connected(false), receiveBuffer(ReceiveBufferSize), readOffset(0), writeOffset(0), 
+      sendOffset(0), localCapabilities(CAP_COMPACT_STATE), sessionCapabilities(0), capabilitiesEpoch(0),
+      socketBytesReceived(0), socketSendCalls(0), nextPingSequence(0),
+      ioRunning(false), flushRequested(false), holdingInbound(false) 
 {
+    sendBuffer.reserve(FlushThreshold + MaxPacketSize);
+
     // Imposta il socket come NON-BLOCCANTE.
     // Questo è vitale: se il server non risponde, il gioco NON deve freezarsi.
     socket.setBlocking(false); 
@@ -46,8 +51,20 @@ bool NetworkClient::connect(const std::string& ip, unsigned short port)
     if (status == sf::Socket::Status::Done) 
     {
         connected = true;
+        readOffset = writeOffset = 0;
+        sendBuffer.clear();
+        sendOffset = 0;
+        // Fino al primo NET_CAPS si usano solo i pacchetti classici
+        sessionCapabilities = 0;
         std::cout << "Connesso al server Go " << ip << ":" << port << std::endl;
         socket.setBlocking(false); // Rimettiamo non-blocking per il gioco
+
+        // Hello: diciamo al server cosa sappiamo leggere
+        PacketHello hello;
+        hello.header.type = PacketType::HELLO;
+        hello.capabilities = localCapabilities;
+        sendPacket(hello);
+        flush();
         return true;
     } 
     else 
@@ -60,8 +77,15 @@ bool NetworkClient::connect(const std::string& ip, unsigned short port)
 
 void NetworkClient::disconnect() 
 {
+    // Quello che è ancora in coda parte prima di chiudere
+    // (se c'è il thread di rete lo fa lui prima di fermarsi)
+    stopIoThread();
+    flush();
     socket.disconnect();
     connected = false;
+    readOffset = writeOffset = 0;
+    sendBuffer.clear();
+    sendOffset = 0;
 }
 
 bool NetworkClient::isConnected() const 
@@ -74,8 +98,312 @@ sf::TcpSocket& NetworkClient::getSocket()
     return socket;
 }
 
-sf::Socket::Status NetworkClient::receive(void* data, std::size_t size, std::size_t& received) 
+NetworkStats NetworkClient::getStats() const
+{
+    NetworkStats result = stats;
+    result.bytesReceived = socketBytesReceived.load(std::memory_order_relaxed);
+    result.sendCalls = socketSendCalls.load(std::memory_order_relaxed);
+    return result;
+}
+
+void NetworkClient::enqueue(const void* data, std::size_t size)
+{
+    // Il server Go scarterebbe comunque il pacchetto (e chiuderebbe la connessione)
+    if (size > MaxPacketSize)
+    {
+        std::cerr << "Pacchetto troppo grande (" << size << " byte), non inviato" << std::endl;
+        return;
+    }
+    stats.packetsSent++;
+    stats.bytesSent += size;
+
+    if (isIoThreadRunning())
+    {
+        Frame* frame = outbound->acquireSlot();
+        // Coda piena: il thread di rete la svuota nel giro di un millisecondo
+        while (frame == nullptr)
+        {
+            if (!connected) return;
+            std::this_thread::yield();
+            frame = outbound->acquireSlot();
+        }
+        frame->size = static_cast<uint32_t>(size);
+        std::memcpy(frame->data, data, size);
+        outbound->commit();
+        return;
+    }
+
+    const char* bytes = static_cast<const char*>(data);
+    sendBuffer.insert(sendBuffer.end(), bytes, bytes + size);
+
+    if (sendBuffer.size() - sendOffset >= FlushThreshold)
+        flush();
+}
+
+void NetworkClient::flush()
+{
+    if (isIoThreadRunning())
+    {
+        // I frame sono già in coda (commit prima di questo store): il thread li spedisce insieme
+        flushRequested.store(true, std::memory_order_release);
+        return;
+    }
+    writeToSocket();
+}
+
+void NetworkClient::writeToSocket()
+{
+    if (!connected || sendOffset == sendBuffer.size()) return;
+
+    std::size_t sent = 0;
+    sf::Socket::Status status = socket.send(sendBuffer.data() + sendOffset, sendBuffer.size() - sendOffset, sent);
+    socketSendCalls.fetch_add(1, std::memory_order_relaxed);
+    sendOffset += sent;
+
+    if (status == sf::Socket::Disconnected || status == sf::Socket::Error)
+    {
+        std::cerr << "Errore invio pacchetti, disconnessione" << std::endl;
+        sendBuffer.clear();
+        sendOffset = 0;
+        connected = false;
+        return;
+    }
+
+    if (sendOffset == sendBuffer.size())
+    {
+        sendBuffer.clear();
+        sendOffset = 0;
+    }
+    // Partial/NotReady: il socket è pieno, il resto (anche un frame a metà) riparte al prossimo flush
+    else if (sendBuffer.size() - sendOffset > MaxPendingBytes)
+    {
+        // Il server non legge più: inutile accumulare all'infinito
+        std::cerr << "Il server non riceve piu' (" << sendBuffer.size() - sendOffset << " byte in coda), disconnessione" << std::endl;
+        sendBuffer.clear();
+        sendOffset = 0;
+        socket.disconnect();
+        connected = false;
+    }
+    else if (sendOffset >= FlushThreshold)
+    {
+        // Compatta: i byte già spediti non servono più
+        sendBuffer.erase(sendBuffer.begin(), sendBuffer.begin() + sendOffset);
+        sendOffset = 0;
+    }
+}
+
+void NetworkClient::poll()
+{
+    if (isIoThreadRunning()) return;
+    readFromSocket();
+}
+
+void NetworkClient::readFromSocket()
+{
+    if (!connected) return;
+
+    // Sposta all'inizio l'eventuale frame incompleto: lo spazio libero resta tutto in coda
+    if (readOffset > 0)
+    {
+        std::memmove(receiveBuffer.data(), receiveBuffer.data() + readOffset, writeOffset - readOffset);
+        writeOffset -= readOffset;
+        readOffset = 0;
+    }
+
+    while (writeOffset < receiveBuffer.size())
+    {
+        std::size_t space = receiveBuffer.size() - writeOffset;
+        std::size_t received = 0;
+        sf::Socket::Status status = socket.receive(receiveBuffer.data() + writeOffset, space, received);
+        writeOffset += received;
+        socketBytesReceived.fetch_add(received, std::memory_order_relaxed);
+
+        if (status == sf::Socket::Disconnected)
+        {
+            std::cerr << "Connessione al server persa!" << std::endl;
+            connected = false;
+            return;
+        }
+        // Se non ha riempito il buffer il socket è vuoto: inutile un'altra chiamata
+        if (status != sf::Socket::Done || received < space)
+            return;
+    }
+}
+
+bool NetworkClient::nextPacket(PacketView& packet)
+{
+    if (isIoThreadRunning())
+    {
+        // Il frame restituito la volta scorsa è stato processato: lo slot torna al thread di rete
+        if (holdingInbound)
+        {
+            inbound->pop();
+            holdingInbound = false;
+        }
+        Frame* frame = inbound->front();
+        if (frame == nullptr) return false;
+
+        packet.data = frame->data;
+        packet.size = frame->size;
+        holdingInbound = true;
+        stats.packetsReceived++;
+        return true;
+    }
+
+    if (!parseFrame(packet)) return false;
+    stats.packetsReceived++;
+    return true;
+}
+
+bool NetworkClient::parseFrame(PacketView& packet)
+{
+    std::size_t available = writeOffset - readOffset;
+    if (available < sizeof(PacketHeader)) return false;
+
+    PacketHeader header;
+    std::memcpy(&header, receiveBuffer.data() + readOffset, sizeof(header));
+
+    // Dimensione impossibile: lo stream è corrotto e non si può ritrovare l'inizio del prossimo frame
+    if (header.packetSize < sizeof(PacketHeader) || header.packetSize > MaxPacketSize)
+    {
+        std::cerr << "Pacchetto non valido (tipo " << header.type << ", size " << header.packetSize << "), disconnessione" << std::endl;
+        socket.disconnect();
+        connected = false;
+        readOffset = writeOffset = 0;
+        return false;
+    }
+
+    // Frame a metà: il resto arriverà con la prossima lettura
+    if (available < header.packetSize) return false;
+
+    packet.data = receiveBuffer.data() + readOffset;
+    packet.size = header.packetSize;
+    readOffset += header.packetSize;
+    return true;
+}
+
+bool NetworkClient::startIoThread()
+{
+    if (!connected || isIoThreadRunning()) return false;
+
+    inbound = std::make_unique<SpscQueue<Frame, QueueCapacity>>();
+    outbound = std::make_unique<SpscQueue<Frame, QueueCapacity>>();
+    holdingInbound = false;
+    flushRequested = false;
+
+    // Quello che il gioco ha già accodato passa al thread insieme al socket
+    ioRunning = true;
+    ioThread = std::thread(&NetworkClient::ioLoop, this);
+    return true;
+}
+
+void NetworkClient::stopIoThread()
+{
+    if (!isIoThreadRunning()) return;
+
+    ioRunning = false;
+    ioThread.join();
+    // Pacchetti ricevuti ma non ancora letti dal gioco: persi con la chiusura
+    inbound.reset();
+    outbound.reset();
+    holdingInbound = false;
+}
+
+void NetworkClient::ioLoop()
 {
-    if (!connected) return sf::Socket::Status::Error;
-    return socket.receive(data, size, received);
+    sf::SocketSelector selector;
+    selector.add(socket);
+    bool flushDue = false;
+    bool readable = true;
+
+    while (ioRunning.load(std::memory_order_acquire) && connected)
+    {
+        // USCITA: prima il flag, poi la coda, così i frame del frame chiuso ci sono tutti
+        if (flushRequested.exchange(false, std::memory_order_acq_rel))
+            flushDue = true;
+        drainOutbound();
+        // Un'unica scrittura per frame (o prima, se si accumula troppo);
+        // un invio parziale viene ripreso al giro successivo
+        if (flushDue || sendBuffer.size() - sendOffset >= FlushThreshold)
+        {
+            writeToSocket();
+            flushDue = sendOffset < sendBuffer.size();
+        }
+
+        // ENTRATA: svuota il socket e passa al gioco i pacchetti completi
+        if (readable)
+            readFromSocket();
+        publishInbound();
+
+        // Attesa: al massimo 1 ms (per i flush del gioco), meno se arrivano dati
+        readable = selector.wait(sf::milliseconds(1));
+    }
+
+    // Ultimo giro: quello che il gioco ha già accodato parte prima di chiudere
+    drainOutbound();
+    writeToSocket();
+}
+
+void NetworkClient::drainOutbound()
+{
+    while (Frame* frame = outbound->front())
+    {
+        sendBuffer.insert(sendBuffer.end(), frame->data, frame->data + frame->size);
+        outbound->pop();
+    }
+}
+
+// Copia i pacchetti completi nella coda del gioco finché c'è posto;
+// se è piena restano nel buffer di ricezione (e il socket aspetta)
+void NetworkClient::publishInbound()
+{
+    PacketView packet;
+    while (Frame* frame = inbound->acquireSlot())
+    {
+        if (!parseFrame(packet)) return;
+        frame->size = static_cast<uint32_t>(packet.size);
+        std::memcpy(frame->data, packet.data, packet.size);
+        inbound->commit();
+    }
+}
+
+void NetworkClient::setCompactStateEnabled(bool enabled)
+{
+    if (enabled)
+        localCapabilities |= CAP_COMPACT_STATE;
+    else
+        localCapabilities &= ~static_cast<uint32_t>(CAP_COMPACT_STATE);
+}
+
+void NetworkClient::onNetCaps(const PacketNetCaps& packet)
+{
+    sessionCapabilities = packet.capabilities & localCapabilities;
+    capabilitiesEpoch = packet.epoch;
+}
+
+void NetworkClient::sendPing()
+{
+    if (!connected) return;
+
+    PacketPing ping;
+    ping.header.type = PacketType::PING;
+    ping.header.packetSize = sizeof(PacketPing);
+    ping.sequence = nextPingSequence++;
+    ping.padding = 0;
+    ping.sendTime = static_cast<uint64_t>(clock.getElapsedTime().asMicroseconds());
+
+    sendPacket(ping);
+    stats.pingsSent++;
+}
+
+void NetworkClient::onPing(const PacketPing& packet)
+{
+    uint64_t now = static_cast<uint64_t>(clock.getElapsedTime().asMicroseconds());
+    if (packet.sendTime > now) return; // Non è un nostro ping
+
+    float rttMs = static_cast<float>(now - packet.sendTime) / 1000.f;
+    stats.lastRttMs = rttMs;
+    stats.averageRttMs = (stats.pingsReceived == 0) ? rttMs : stats.averageRttMs * 0.9f + rttMs * 0.1f;
+    if (rttMs > stats.maxRttMs) stats.maxRttMs = rttMs;
+    stats.pingsReceived++;
 }
\ No newline at end of file
@@ -1,23 +1,93 @@
 #pragma once
 #include <SFML/Network.hpp>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 
-class NetMessages;
+#include "NetMessages.h"
+#include "SpscQueue.h"
 
+// Contatori di traffico e latenza di una connessione (per i bot di carico e il debug)
+struct NetworkStats
+{
+    uint64_t packetsSent = 0;
+    uint64_t bytesSent = 0;
+    uint64_t sendCalls = 0;     // scritture sul socket (più pacchetti per scrittura)
+    uint64_t packetsReceived = 0;
+    uint64_t bytesReceived = 0;
+    uint32_t pingsSent = 0;
+    uint32_t pingsReceived = 0;
+    float lastRttMs = 0.f;
+    float averageRttMs = 0.f;  // media mobile esponenziale
+    float maxRttMs = 0.f;
+};
+
+// Un pacchetto completo ricevuto, letto direttamente dal buffer di ricezione (header incluso).
+// Valido fino alla prossima chiamata a nextPacket() o poll().
+struct PacketView
+{
+    const char* data = nullptr;
+    std::size_t size = 0;
+
+    uint32_t type() const { return reinterpret_cast<const PacketHeader*>(data)->type; }
+
+    // Il pacchetto come struct T (pack(1): nessun vincolo di allineamento); nullptr se troppo corto
+    template <typename T>
+    const T* as() const
+    {
+        return size >= sizeof(T) ? reinterpret_cast<const T*>(data) : nullptr;
+    }
+};
+
+// Connessione TCP al server Go.
+// Il gioco usa l'istanza condivisa (getInstance); i bot headless ne creano una per bot.
+// Di default il socket viene letto/scritto dal thread che chiama poll()/flush();
+// con startIoThread() lo gestisce un thread dedicato e il gioco scambia solo pacchetti
+// interi con lui, attraverso due code senza lock.
 class NetworkClient 
 {
     private:
         static NetworkClient* instance;
         sf::TcpSocket socket;
-        bool connected;
+        std::atomic<bool> connected;  // scritto anche dal thread di rete
 
-        // Costruttore privato (Singleton)
-        NetworkClient();
+        // Ricezione: il socket viene svuotato a blocchi in questo buffer e i pacchetti
+        // completi vengono letti sul posto; un frame a metà resta qui finché non arriva il resto
+        static constexpr std::size_t ReceiveBufferSize = 64 * 1024;
+        std::vector<char> receiveBuffer;
+        std::size_t readOffset;   // inizio del primo pacchetto non ancora consumato
+        std::size_t writeOffset;  // fine dei dati ricevuti
+
+        // Invio: i pacchetti del frame si accumulano qui e partono tutti insieme con flush().
+        // [sendOffset, size) è ancora da spedire (il socket non-bloccante può accettarne solo una parte)
+        std::vector<char> sendBuffer;
+        std::size_t sendOffset;
+
+        // Capacità: le nostre (annunciate nell'hello) e quelle comuni a tutta la sessione (NET_CAPS)
+        uint32_t localCapabilities;
+        uint32_t sessionCapabilities;
+        uint32_t capabilitiesEpoch;
+
+        NetworkStats stats;
+        // Contatori aggiornati da chi usa il socket (anche il thread di rete), uniti in getStats()
+        std::atomic<uint64_t> socketBytesReceived;
+        std::atomic<uint64_t> socketSendCalls;
+        sf::Clock clock;       // base dei tempi dei ping
+        uint32_t nextPingSequence;
 
     public:
+        // Dimensione massima di un pacchetto (stesso limite del server Go)
+        static constexpr uint32_t MaxPacketSize = 1024;
+
+        NetworkClient();
         ~NetworkClient();
+        NetworkClient(const NetworkClient&) = delete;
+        NetworkClient& operator=(const NetworkClient&) = delete;
         
-        // Accesso statico
+        // Istanza condivisa del gioco
         static NetworkClient* getInstance();
         static void destroyInstance();
         
@@ -27,7 +97,8 @@ class NetworkClient
         bool isConnected() const;
 
         // INVIO (Template per comodità)
-        // Questa funzione magica accetta qualsiasi struct (Move, Login) e la spedisce
+        // Questa funzione magica accetta qualsiasi struct (Move, Login) e la accoda:
+        // parte con il prossimo flush() (a fine update) o subito se il buffer è pieno
         template <typename T>
         void sendPacket(T& packet)
         {
@@ -35,34 +106,80 @@ class NetworkClient
                 return;
 
             packet.header.packetSize = sizeof(T);
+            enqueue(&packet, sizeof(T));
+        }
 
-            const char* data = reinterpret_cast<const char*>(&packet);
-            std::size_t totalSent = 0;
-            std::size_t size = sizeof(T);
-
-            while (totalSent < size)
-            {
-                std::size_t sent = 0;
-                sf::Socket::Status status = socket.send(
-                    data + totalSent,
-                    size - totalSent,
-                    sent
-                );
-
-                if (status != sf::Socket::Done)
-                {
-                    std::cerr << "Errore invio pacchetto!" << std::endl;
-                    return;
-                }
-
-                totalSent += sent;
-            }
+        // Pacchetti a dimensione variabile (es. snapshot): 'data' inizia con un PacketHeader
+        // già compilato, packetSize compreso
+        void sendBytes(const void* data, std::size_t size)
+        {
+            if (!connected)
+                return;
+
+            enqueue(data, size);
         }
 
+        // Oltre questa soglia di byte in coda si spedisce senza aspettare la fine del frame
+        static constexpr std::size_t FlushThreshold = 16 * 1024;
+        // Byte in coda oltre i quali il server è considerato irraggiungibile
+        static constexpr std::size_t MaxPendingBytes = 1024 * 1024;
+        // Spedisce in un'unica scrittura tutto quello che è in coda
+        void flush();
+
+        // CAPACITÀ (negoziate all'inizio: hello del client, NET_CAPS del server)
+        // Da chiamare prima di connect(): false = il client si presenta come una versione vecchia
+        void setCompactStateEnabled(bool enabled);
+        void onNetCaps(const PacketNetCaps& packet);
+        // Tutti i client della sessione capiscono MOVE_COMPACT / ENEMY_SNAPSHOT_COMPACT
+        bool useCompactState() const { return (sessionCapabilities & CAP_COMPACT_STATE) != 0; }
+        // Cambia ad ogni NET_CAPS: chi codifica a delta deve ripartire da stati completi
+        uint32_t getCapabilitiesEpoch() const { return capabilitiesEpoch; }
+
+        // Latenza: invia un PING, il server lo rimanda e onPing() aggiorna le statistiche
+        void sendPing();
+        void onPing(const PacketPing& packet);
+        NetworkStats getStats() const;
 
-        // RICEZIONE (Semplificata per ora)
-        // Cerca di ricevere dati nel buffer
-        sf::Socket::Status receive(void* data, std::size_t size, std::size_t& received);
+        // RICEZIONE
+        // Legge dal socket tutto quello che è arrivato (di solito una sola chiamata di sistema).
+        // Con il thread di rete attivo non fa nulla: legge lui.
+        void poll();
+        // Prossimo pacchetto completo nel buffer; false se non ce ne sono altri per ora
+        bool nextPacket(PacketView& packet);
+        
+        // THREAD DI RETE (opzionale, dopo connect())
+        // Da qui in poi socket, buffer di invio e di ricezione sono suoi: ogni pacchetto
+        // decodificato arriva in una coda letta da nextPacket(), ogni sendPacket() finisce
+        // in una coda che il thread spedisce al flush(). Un invio lento o una raffica di
+        // pacchetti non pesano più sul frame.
+        bool startIoThread();
+        void stopIoThread();   // spedisce quello che è in coda, poi ferma il thread
+        bool isIoThreadRunning() const { return ioThread.joinable(); }
         
         sf::TcpSocket& getSocket(); // Getter se serve accesso diretto
+
+    private:
+        // Un pacchetto intero nelle code fra gioco e thread di rete
+        struct Frame
+        {
+            uint32_t size;
+            char data[MaxPacketSize];
+        };
+        static constexpr std::size_t QueueCapacity = 1024;
+
+        std::unique_ptr<SpscQueue<Frame, QueueCapacity>> inbound;   // thread di rete -> gioco
+        std::unique_ptr<SpscQueue<Frame, QueueCapacity>> outbound;  // gioco -> thread di rete
+        std::thread ioThread;
+        std::atomic<bool> ioRunning;
+        std::atomic<bool> flushRequested;  // il gioco ha chiuso il frame: spedire
+        bool holdingInbound;  // nextPacket() ha restituito un frame della coda, da liberare
+
+        void enqueue(const void* data, std::size_t size);
+        void ioLoop();
+        // Operazioni sul socket: le fa il thread di rete se attivo, altrimenti chi chiama poll()/flush()
+        void writeToSocket();
+        void readFromSocket();
+        bool parseFrame(PacketView& packet);
+        void publishInbound();
+        void drainOutbound();
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Coda circolare senza lock fra un solo produttore e un solo consumatore.
+// Gli elementi si scrivono e si leggono sul posto (niente copie intermedie):
+//   produttore: acquireSlot() -> riempi -> commit()
+//   consumatore: front() -> leggi -> pop()
+// Capacity deve essere una potenza di 2.
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+private:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity deve essere una potenza di 2");
+    static constexpr std::size_t Mask = Capacity - 1;
+
+    std::unique_ptr<T[]> slots;
+    // Contatori monotoni: head è scritto solo dal consumatore, tail solo dal produttore.
+    // Su cache line separate, così i due thread non si contendono la stessa riga.
+    alignas(64) std::atomic<std::size_t> head{ 0 };
+    alignas(64) std::atomic<std::size_t> tail{ 0 };
+
+public:
+    SpscQueue() : slots(new T[Capacity]) {}
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Produttore: slot libero da riempire, nullptr se la coda è piena
+    T* acquireSlot()
+    {
+        std::size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == Capacity)
+            return nullptr;
+        return &slots[currentTail & Mask];
+    }
+
+    // Produttore: rende visibile al consumatore lo slot riempito
+    void commit()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumatore: elemento più vecchio, nullptr se la coda è vuota
+    T* front()
+    {
+        std::size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire))
+            return nullptr;
+        return &slots[currentHead & Mask];
+    }
+
+    // Consumatore: libera l'elemento restituito da front()
+    void pop()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
@@ -0,0 +1,178 @@
+// Server dedicato: simula i nemici (AI, danni, livelli) al posto del player host.
+// Si collega al relay Go come un client qualsiasi, senza finestra né player locale,
+// e annuncia ai client di essere l'host (HOST_ANNOUNCE).
+//
+// Uso: APL_Server [host=127.0.0.1] [porta=8080]
+
+#include <SFML/System.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Game.h"
+#include "Scene.h"
+#include "Level.h"
+#include "NetworkClient.h"
+#include "NetMessages.h"
+#include "TextureCache.h"
+#include "CharacterAtlas.h"
+#include "ParticleSystem.h"
+#include "AnimationClip.h"
+
+// Stesso passo fisso dei client
+constexpr float SIMULATION_DT = 1.f / 60.f;
+constexpr int MAX_TICKS_PER_FRAME = 5;
+// Snapshot dei nemici al secondo
+constexpr float NET_TICK_RATE = 20.f;
+// Ogni quanto ripetere l'annuncio (per i client arrivati dopo)
+constexpr float ANNOUNCE_INTERVAL = 2.f;
+constexpr float REPORT_INTERVAL = 5.f;
+
+// Ritorna false (senza spedire) finché il relay non ci ha assegnato un ID con il LOGIN
+static bool announceHost(Scene& scene)
+{
+    if (scene.getLocalPlayerId() < 0)
+        return false;
+
+    PacketHostAnnounce announce;
+    announce.header.type = PacketType::HOST_ANNOUNCE;
+    announce.header.packetSize = sizeof(PacketHostAnnounce);
+    announce.hostPlayerId = static_cast<uint32_t>(scene.getLocalPlayerId()); // il relay lo forza al nostro ID
+    scene.getNetwork().sendPacket(announce);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string host = argc > 1 ? argv[1] : "127.0.0.1";
+    unsigned short port = argc > 2 ? static_cast<unsigned short>(std::atoi(argv[2])) : 8080;
+
+    // Game senza finestra: niente texture su GPU, particelle, HUD e focus
+    Game* game = Game::createHeadless();
+
+    NetworkClient* network = NetworkClient::getInstance();
+    if (!network->connect(host, port))
+    {
+        std::cerr << "Server dedicato: impossibile raggiungere il relay " << host << ":" << port << std::endl;
+        Game::destroyInstance();
+        NetworkClient::destroyInstance();
+        TextureCache::destroyInstance();
+        ParticleSystem::destroyInstance();
+        CharacterAtlas::destroyInstance();
+        return 1;
+    }
+
+    // Scena senza player locale: i player sono tutti remoti (creati dai loro MOVE)
+    Scene* scene = new Scene(*network);
+    game->setScene(scene);
+    game->setIsHost(true);
+    scene->setNetTickRate(NET_TICK_RATE);
+    Level::build(*scene);
+    scene->prewarmEnemies(Level::MaxEnemiesPerLevel);
+
+    auto startLevel = [&](int level) {
+        int numEnemies = Level::spawnEnemies(*scene, level);
+        game->setEnemiesToDefeat(numEnemies);
+        std::cout << "Livello " << level << " - " << numEnemies << " nemici" << std::endl;
+    };
+
+    // La partita parte col primo giocatore (così riceve gli ENEMY_SPAWN)
+    // e ricomincia dal livello 1 quando se ne vanno tutti
+    bool matchRunning = false;
+
+    sf::Clock clock;
+    sf::Clock tickClock;
+    float accumulator = 0.f;
+    float announceTimer = 0.f;
+    float reportTimer = 0.f;
+    float tickSeconds = 0.f;  // tempo speso a simulare dall'ultimo report
+    int tickCount = 0;
+    NetworkStats lastStats;
+    while (network->isConnected())
+    {
+        float frameTime = clock.restart().asSeconds();
+        accumulator += frameTime;
+        announceTimer -= frameTime;
+        reportTimer += frameTime;
+
+        int ticks = 0;
+        while (accumulator >= SIMULATION_DT && ticks < MAX_TICKS_PER_FRAME)
+        {
+            tickClock.restart();
+
+            bool hasPlayers = !scene->getPlayers().empty();
+            if (!matchRunning && hasPlayers)
+            {
+                std::cout << "Primo giocatore arrivato, inizia la partita" << std::endl;
+                // Annuncio prima degli ENEMY_SPAWN: un client che si era fatto host cede
+                // (e azzera il contatore) prima di ricevere i nostri nemici
+                announceHost(*scene);
+                announceTimer = ANNOUNCE_INTERVAL;
+                game->restartGame();
+                startLevel(1);
+                matchRunning = true;
+            }
+            else if (matchRunning && !hasPlayers)
+            {
+                std::cout << "Nessun giocatore, partita sospesa" << std::endl;
+                scene->removeAllEnemies();
+                game->setEnemiesToDefeat(0);
+                matchRunning = false;
+            }
+
+            if (matchRunning && game->isLevelComplete())
+            {
+                game->nextLevel();
+                scene->removeAllEnemies();
+                startLevel(game->getCurrentLevel());
+            }
+
+            // AI, danni, fisica e rete: quello che prima girava sul player host
+            game->update(SIMULATION_DT);
+
+            tickSeconds += tickClock.getElapsedTime().asSeconds();
+            tickCount++;
+            accumulator -= SIMULATION_DT;
+            ticks++;
+        }
+        // Se siamo troppo indietro scartiamo il tempo residuo invece di accumularlo
+        if (ticks == MAX_TICKS_PER_FRAME && accumulator > SIMULATION_DT)
+            accumulator = 0.f;
+
+        if (announceTimer <= 0.f && announceHost(*scene))
+        {
+            announceTimer = ANNOUNCE_INTERVAL;
+        }
+
+        if (reportTimer >= REPORT_INTERVAL)
+        {
+            const NetworkStats& stats = network->getStats();
+            std::printf("[server] tick medio %.2fms | giocatori %zu, nemici %zu, livello %d | out %.0f p/s %.0f B/s, in %.0f p/s %.0f B/s\n",
+                        tickCount > 0 ? 1000.f * tickSeconds / tickCount : 0.f,
+                        scene->getPlayers().size(), scene->getEnemies().size(), game->getCurrentLevel(),
+                        (stats.packetsSent - lastStats.packetsSent) / reportTimer,
+                        (stats.bytesSent - lastStats.bytesSent) / reportTimer,
+                        (stats.packetsReceived - lastStats.packetsReceived) / reportTimer,
+                        (stats.bytesReceived - lastStats.bytesReceived) / reportTimer);
+            std::fflush(stdout);
+            lastStats = stats;
+            reportTimer = 0.f;
+            tickSeconds = 0.f;
+            tickCount = 0;
+        }
+
+        // Dormi fino al prossimo tick
+        sf::sleep(sf::seconds(SIMULATION_DT - accumulator));
+    }
+    std::cout << "Relay disconnesso, chiusura del server dedicato" << std::endl;
+
+    // Pulizia finale (stesso ordine del gioco)
+    Game::destroyInstance();          // Cancella Game (che cancella anche Scene)
+    NetworkClient::destroyInstance();
+    TextureCache::destroyInstance();
+    ParticleSystem::destroyInstance();
+    AnimationLibrary::destroyInstance();
+    CharacterAtlas::destroyInstance();
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "AnimationClip.h"
+#include "CharacterAtlas.h"
+
+// Inizializzazione membro statico
+AnimationLibrary* AnimationLibrary::instance = nullptr;
+
+AnimationLibrary* AnimationLibrary::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new AnimationLibrary();
+    }
+    return instance;
+}
+
+void AnimationLibrary::destroyInstance()
+{
+    delete instance;
+    instance = nullptr;
+}
+
+namespace
+{
+    // Definizione di una clip: nomi dei file nella cartella del personaggio
+    struct ClipDef
+    {
+        ClipId id;
+        std::vector<std::string> frames;
+        float frameDuration;
+        bool loop;
+        sf::IntRect crop;
+    };
+
+    // Ritagli del personaggio nel frame 96x54 (l'attacco è più largo per l'arma)
+    const sf::IntRect BodyCrop(41, 24, 15, 30);
+    const sf::IntRect AttackCrop(41, 24, 40, 30);
+
+    const std::vector<ClipDef> PlayerClipDefs = {
+        { ClipId::Idle,   { "Idle" },                                   0.1f,  true,  BodyCrop },
+        { ClipId::Walk,   { "Walk_1", "Walk_2", "Walk_3", "Walk_4" },   0.1f,  true,  BodyCrop },
+        { ClipId::Jump,   { "Jump_1" },                                 0.1f,  true,  BodyCrop },
+        { ClipId::Fall,   { "Fall" },                                   0.1f,  true,  BodyCrop },
+        { ClipId::Attack, { "A1", "A2" },                               0.1f,  false, AttackCrop },
+    };
+
+    const std::vector<ClipDef> EnemyClipDefs = {
+        { ClipId::Idle,   { "Idle" },                                   0.1f,  true,  BodyCrop },
+        { ClipId::Walk,   { "Walk_1", "Walk_2", "Walk_3", "Walk_4" },   0.1f,  true,  BodyCrop },
+        { ClipId::Attack, { "A1", "A2" },                               0.15f, false, AttackCrop },
+    };
+}
+
+const CharacterClips& AnimationLibrary::getClips(const std::string& folder, CharacterKind kind)
+{
+    std::string key = folder + (kind == CharacterKind::Player ? "/player" : "/enemy");
+    auto it = tables.find(key);
+    if (it != tables.end())
+        return it->second;
+
+    CharacterClips& table = tables[key];
+    CharacterAtlas* atlas = CharacterAtlas::getInstance();
+    const std::vector<ClipDef>& defs = (kind == CharacterKind::Player) ? PlayerClipDefs : EnemyClipDefs;
+
+    for (const ClipDef& def : defs)
+    {
+        AnimationClip& clip = table.clips[static_cast<int>(def.id)];
+        for (const std::string& name : def.frames)
+        {
+            clip.frames.push_back(&atlas->getFrame(folder, name));
+        }
+        clip.frameDuration = def.frameDuration;
+        clip.loop = def.loop;
+        clip.crop = def.crop;
+    }
+    // Le clip non definite (es. salto per i nemici) ricadono sull'idle
+    for (AnimationClip& clip : table.clips)
+    {
+        if (clip.frames.empty())
+            clip = table[ClipId::Idle];
+    }
+    return table;
+}
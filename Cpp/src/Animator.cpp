@@ -0,0 +1,111 @@
+#include "Animator.h"
+#include "AnimationClip.h"
+#include "CharacterAtlas.h"
+
+uint32_t Animator::createAnimator(sf::Sprite& target, const AnimationClip& initialClip)
+{
+    uint32_t animator;
+    if (!freeList.empty())
+    {
+        animator = freeList.back();
+        freeList.pop_back();
+    }
+    else
+    {
+        animator = static_cast<uint32_t>(clip.size());
+        clip.push_back(nullptr);
+        sprite.push_back(nullptr);
+        timer.push_back(0.f);
+        frame.push_back(0);
+        facingRight.push_back(1);
+        playing.push_back(0);
+        finished.push_back(0);
+        dirty.push_back(0);
+        inUse.push_back(0);
+    }
+
+    clip[animator] = &initialClip;
+    sprite[animator] = &target;
+    timer[animator] = 0.f;
+    frame[animator] = 0;
+    facingRight[animator] = 1;
+    playing[animator] = 1;
+    finished[animator] = 0;
+    inUse[animator] = 1;
+
+    // Il primo frame viene applicato subito: lo sprite è valido già prima del primo update
+    apply(animator);
+    return animator;
+}
+
+void Animator::destroyAnimator(uint32_t animator)
+{
+    if (animator >= inUse.size() || !inUse[animator]) return;
+    inUse[animator] = 0;
+    playing[animator] = 0;
+    dirty[animator] = 0;
+    sprite[animator] = nullptr;
+    freeList.push_back(animator);
+}
+
+void Animator::play(uint32_t animator, const AnimationClip& newClip, bool restart)
+{
+    playing[animator] = 1;
+    if (clip[animator] == &newClip && !restart) return;
+
+    clip[animator] = &newClip;
+    timer[animator] = 0.f;
+    frame[animator] = 0;
+    finished[animator] = 0;
+    dirty[animator] = 1;
+}
+
+void Animator::update(float dt)
+{
+    std::size_t count = clip.size();
+
+    // Avanzamento dei timer: solo gli animator il cui frame cambia diventano "dirty"
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (!playing[i] || finished[i]) continue;
+
+        const AnimationClip& current = *clip[i];
+        timer[i] += dt;
+        if (timer[i] < current.frameDuration) continue;
+        timer[i] = 0.f;
+
+        std::size_t next = frame[i] + 1u;
+        if (next >= current.frames.size())
+        {
+            if (!current.loop)
+            {
+                finished[i] = 1; // resta sull'ultimo frame
+                continue;
+            }
+            next = 0;
+        }
+        if (next != frame[i])
+        {
+            frame[i] = static_cast<uint16_t>(next);
+            dirty[i] = 1;
+        }
+    }
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (dirty[i]) apply(static_cast<uint32_t>(i));
+    }
+}
+
+// Texture, ritaglio e verso dello sprite dal frame corrente
+void Animator::apply(uint32_t animator)
+{
+    const AnimationClip& current = *clip[animator];
+    const AtlasFrame* atlasFrame = current.frames[frame[animator]];
+
+    sf::Sprite& target = *sprite[animator];
+    target.setTexture(*atlasFrame->texture);
+    target.setTextureRect(atlasFrame->crop(current.crop));
+    target.setScale(facingRight[animator] ? 1.f : -1.f, 1.f);
+    dirty[animator] = 0;
+}
@@ -1,15 +1,16 @@
 #include "Block.h"
-#include <iostream>
+#include "TextureCache.h"
 
 Block::Block(float x, float y, const std::string& texturePath)
 {
-    if (!texture.loadFromFile(texturePath))
-    {
-        std::cerr << "Could not load texture from " << texturePath << std::endl;
-    }
+    TextureCache* cache = TextureCache::getInstance();
+    texture = cache->load(texturePath);
+    sf::Vector2u size = cache->getImageSize(texturePath);
 
-    sprite.setTexture(texture);
+    sprite.setTexture(*texture);
+    sprite.setTextureRect(sf::IntRect(0, 0, size.x, size.y));
     sprite.setPosition(x, y);
+    bounds = sf::FloatRect(x, y, static_cast<float>(size.x), static_cast<float>(size.y));
 
     // sf::IntRect rect({50,30,16,16});
     // sprite.setTextureRect(rect);
@@ -17,12 +18,7 @@ Block::Block(float x, float y, const std::string& texturePath)
 
 sf::FloatRect Block::getBounds() const
 {
-    return sprite.getGlobalBounds();
-}
-
-void Block::draw(sf::RenderWindow& window)
-{
-    window.draw(sprite);
+    return bounds;
 }
 
 void Block::update(const Scene& scene)
@@ -0,0 +1,41 @@
+#include "Camera.h"
+
+Camera::Camera() : hasWorldBounds(false) {}
+
+void Camera::setWorldBounds(const sf::FloatRect& bounds)
+{
+    worldBounds = bounds;
+    hasWorldBounds = true;
+}
+
+// Limita il centro su un asse: la vista non deve uscire dal livello
+static float clampAxis(float center, float halfSize, float worldMin, float worldSize)
+{
+    if (worldSize <= halfSize * 2.f)
+        return worldMin + worldSize / 2.f;
+    if (center - halfSize < worldMin)
+        return worldMin + halfSize;
+    if (center + halfSize > worldMin + worldSize)
+        return worldMin + worldSize - halfSize;
+    return center;
+}
+
+void Camera::follow(const sf::Vector2f& target, const sf::Vector2f& viewportSize)
+{
+    sf::Vector2f center = target;
+    if (hasWorldBounds)
+    {
+        center.x = clampAxis(center.x, viewportSize.x / 2.f, worldBounds.left, worldBounds.width);
+        center.y = clampAxis(center.y, viewportSize.y / 2.f, worldBounds.top, worldBounds.height);
+    }
+
+    view.setSize(viewportSize);
+    view.setCenter(center);
+}
+
+sf::FloatRect Camera::getVisibleArea() const
+{
+    sf::Vector2f size = view.getSize();
+    sf::Vector2f center = view.getCenter();
+    return sf::FloatRect(center.x - size.x / 2.f, center.y - size.y / 2.f, size.x, size.y);
+}
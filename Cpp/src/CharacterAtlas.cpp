@@ -0,0 +1,95 @@
+#include "CharacterAtlas.h"
+#include <iostream>
+
+// Inizializzazione membro statico
+CharacterAtlas* CharacterAtlas::instance = nullptr;
+
+CharacterAtlas* CharacterAtlas::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new CharacterAtlas();
+    }
+    return instance;
+}
+
+void CharacterAtlas::destroyInstance()
+{
+    delete instance;
+    instance = nullptr;
+}
+
+CharacterAtlas::CharacterAtlas() : cursorX(0), cursorY(0), rowHeight(0), headless(false) {}
+
+void CharacterAtlas::addPage()
+{
+    auto page = std::make_unique<sf::Texture>();
+    if (!page->create(PageSize, PageSize))
+    {
+        std::cerr << "Could not create character atlas page " << PageSize << "x" << PageSize << std::endl;
+    }
+    pages.push_back(std::move(page));
+    cursorX = 0;
+    cursorY = 0;
+    rowHeight = 0;
+}
+
+// Copia l'immagine nella pagina corrente (riga dopo riga), aprendo una nuova pagina se è piena
+bool CharacterAtlas::pack(const sf::Image& image, AtlasFrame& frame)
+{
+    sf::Vector2u size = image.getSize();
+    if (size.x > PageSize || size.y > PageSize)
+    {
+        std::cerr << "Frame " << size.x << "x" << size.y << " troppo grande per l'atlas" << std::endl;
+        return false;
+    }
+
+    if (pages.empty())
+        addPage();
+
+    // Riga piena: vai a capo
+    if (cursorX + size.x > PageSize)
+    {
+        cursorX = 0;
+        cursorY += rowHeight + Padding;
+        rowHeight = 0;
+    }
+    // Pagina piena: nuova pagina
+    if (cursorY + size.y > PageSize)
+        addPage();
+
+    sf::Texture& page = *pages.back();
+    page.update(image, cursorX, cursorY);
+
+    frame.texture = &page;
+    frame.rect = sf::IntRect(cursorX, cursorY, size.x, size.y);
+
+    cursorX += size.x + Padding;
+    if (size.y > rowHeight)
+        rowHeight = size.y;
+    return true;
+}
+
+const AtlasFrame& CharacterAtlas::getFrame(const std::string& folder, const std::string& name)
+{
+    std::string key = folder + "/" + name;
+    auto it = frames.find(key);
+    if (it != frames.end())
+        return it->second;
+
+    AtlasFrame& frame = frames[key];
+    frame.texture = &missingTexture;
+    if (headless)
+        return frame;
+
+    std::string path = "assets/pp1/" + key + ".png";
+    sf::Image image;
+    if (!image.loadFromFile(path))
+    {
+        std::cerr << "Could not load character frame from path " << path << std::endl;
+        return frame;
+    }
+
+    pack(image, frame);
+    return frame;
+}
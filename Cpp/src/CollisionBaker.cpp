@@ -0,0 +1,79 @@
+#include "CollisionBaker.h"
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+// Tolleranza per confrontare coordinate float generate da moltiplicazioni (i * 15.f)
+static constexpr float bakeEpsilon = 0.01f;
+
+static bool nearlyEqual(float a, float b)
+{
+    return std::abs(a - b) <= bakeEpsilon;
+}
+
+// Chiave di ordinamento: coordinata arrotondata alla griglia di bakeEpsilon.
+// nearlyEqual non è transitivo (non è uno strict weak ordering) e non va usato in std::sort
+static long long bakeKey(float v)
+{
+    return std::llround(v / bakeEpsilon);
+}
+
+std::vector<sf::FloatRect> bakeCollisionRects(std::vector<sf::FloatRect> tiles)
+{
+    std::vector<sf::FloatRect> rows;
+    if (tiles.empty()) return rows;
+
+    // 1. File orizzontali
+    std::sort(tiles.begin(), tiles.end(), [](const sf::FloatRect& a, const sf::FloatRect& b) {
+        return std::make_tuple(bakeKey(a.top), bakeKey(a.height), a.left)
+             < std::make_tuple(bakeKey(b.top), bakeKey(b.height), b.left);
+    });
+
+    sf::FloatRect current = tiles[0];
+    for (std::size_t i = 1; i < tiles.size(); i++)
+    {
+        const sf::FloatRect& tile = tiles[i];
+        float right = current.left + current.width;
+
+        bool sameRow = nearlyEqual(tile.top, current.top) && nearlyEqual(tile.height, current.height);
+        if (sameRow && tile.left <= right + bakeEpsilon)
+        {
+            // Contiguo (o sovrapposto): estendi la fila
+            current.width = std::max(right, tile.left + tile.width) - current.left;
+        }
+        else
+        {
+            rows.push_back(current);
+            current = tile;
+        }
+    }
+    rows.push_back(current);
+
+    // 2. Impila le file con stessa x e larghezza
+    std::sort(rows.begin(), rows.end(), [](const sf::FloatRect& a, const sf::FloatRect& b) {
+        return std::make_tuple(bakeKey(a.left), bakeKey(a.width), a.top)
+             < std::make_tuple(bakeKey(b.left), bakeKey(b.width), b.top);
+    });
+
+    std::vector<sf::FloatRect> merged;
+    current = rows[0];
+    for (std::size_t i = 1; i < rows.size(); i++)
+    {
+        const sf::FloatRect& row = rows[i];
+        float bottom = current.top + current.height;
+
+        bool sameColumn = nearlyEqual(row.left, current.left) && nearlyEqual(row.width, current.width);
+        if (sameColumn && row.top <= bottom + bakeEpsilon)
+        {
+            current.height = std::max(bottom, row.top + row.height) - current.top;
+        }
+        else
+        {
+            merged.push_back(current);
+            current = row;
+        }
+    }
+    merged.push_back(current);
+
+    return merged;
+}
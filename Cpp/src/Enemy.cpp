@@ -1,9 +1,14 @@
 #include "Enemy.h"
 #include "Block.h"
 #include "Scene.h"
+#include "SpatialGrid.h"
 #include "Player.h"
 #include "NetworkClient.h"
 #include "NetMessages.h"
+#include "Kinematics.h"
+#include "Animator.h"
+#include "AnimationClip.h"
+#include "RenderSnapshot.h"
 #include <iostream>
 #include <cmath>
 #include <cstdlib>
@@ -13,146 +18,107 @@ static float randomFloat(float min, float max) {
     return min + static_cast<float>(std::rand()) / (static_cast<float>(RAND_MAX / (max - min)));
 }
 
-Enemy::Enemy(std::string Folder, uint32_t id, bool localControl)
-    : Hittable(50.f), velocity(0.0f, 0.0f), isGrounded(false), speed(80.0f), gravity(200.0f),
-      current_animation_frame(0), animation_timer(0.1f), animation_speed(0.1f),
-      facingRight(true), isAttacking(false), attackFrame(0), attackTimer(0.f),
+Enemy::Enemy(Kinematics& kinematics, Animator& animations, NetworkClient& network,
+             std::string Folder, uint32_t id, bool localControl)
+    : Hittable(50.f), kinematics(kinematics), animations(animations), network(network), speed(80.0f),
+      facingRight(true), isAttacking(false),
       attackCooldownTimer(0.f), patrolTimer(0.f), patrolDirection(1.f),
       seesPlayer(false), attackDelayTimer(0.f), enemyId(id), isLocallyControlled(localControl)
 {
-    // Tempi randomici per ogni nemico
-    patrolChangeTime = randomFloat(1.0f, 4.0f);   // Tempo tra cambi direzione
-    attackDelay = randomFloat(0.2f, 1.0f);        // Tempo prima di attaccare
-    attackCooldown = randomFloat(1.0f, 2.5f);     // Cooldown tra attacchi
-    speed = randomFloat(60.0f, 120.0f);           // Velocità movimento
+    randomizeBehaviour();
     
-    sf::Texture texture;
-    std::string path_to_folder = "assets/pp1/" + Folder + "/";  
-    //load idle texture
-    if(!idle_texture.loadFromFile(path_to_folder + "Idle.png"))
-    {
-        std::cerr << "Could not load enemy texture from path " << path_to_folder + "Idle.png" << std::endl;
-    }
-    //load walk textures
-    for(int i = 1; i <= 4; i++)
-    {
-        if(!texture.loadFromFile(path_to_folder + "Walk_" + std::to_string(i) + ".png"))
-        {
-            std::cerr << "Could not load enemy walk texture from path " << path_to_folder + "Walk_" + std::to_string(i) + ".png" << std::endl;
-        }
-        walk_textures.push_back(texture);
-    }
-    //load attack textures
-    if(!texture.loadFromFile(path_to_folder + "A1.png"))
-    {
-        std::cerr << "Could not load enemy attack texture from path " << path_to_folder + "A1.png" << std::endl;
-    }
-    attack_textures.push_back(texture);
-    if(!texture.loadFromFile(path_to_folder + "A2.png"))
-    {
-        std::cerr << "Could not load enemy attack texture from path " << path_to_folder + "A2.png" << std::endl;
-    }
-    attack_textures.push_back(texture);
-
-    // Setup sprite
-    sprite.setTexture(idle_texture);
+    // Clip condivise: solo il primo nemico legge i frame da disco
+    clips = &AnimationLibrary::getInstance()->getClips(Folder, CharacterKind::Enemy);
     
-    // Dimensioni del personaggio nella texture
-    float characterStartX = 41.f;
-    float characterStartY = 24.0f;
-    float characterWidth = 15.f;
-    float characterHeight = 30.f;
+    // Dimensioni del personaggio: il ritaglio dell'idle
+    const sf::IntRect& crop = (*clips)[ClipId::Idle].crop;
+    float characterWidth = static_cast<float>(crop.width);
+    float characterHeight = static_cast<float>(crop.height);
     
-    // Imposta il textureRect
-    sprite.setTextureRect(sf::IntRect(
-        characterStartX,
-        characterStartY,
-        characterWidth,
-        characterHeight
-    ));
+    // L'animator imposta texture e textureRect dello sprite
+    animator = animations.createAnimator(sprite, (*clips)[ClipId::Idle]);
     
     // Imposta l'origine al centro
     sprite.setOrigin(characterWidth / 2.f, characterHeight / 2.f);
     
+    // Body cinematico: collider più stretto del personaggio, centrato sull'origine
+    body = kinematics.createBody(characterWidth * 0.75f, characterHeight, 200.0f);
+    
     // Posizione iniziale
+    kinematics.teleport(body, 300.f, 100.f);
     sprite.setPosition(300.f, 100.f);
-    
-    // Configura il collider
-    collider.width = characterWidth * 0.75f;
-    collider.height = characterHeight;
-    
-    colliderOffsetX = (characterWidth - collider.width) / 2.f;
-    colliderOffsetY = characterHeight - collider.height;
-    
-    updateCollider();
 }
 
-void Enemy::apply_gravity(float dt)
+Enemy::~Enemy()
 {
-    velocity.y += gravity * dt;
+    animations.destroyAnimator(animator);
+    kinematics.destroyBody(body);
 }
 
-void Enemy::moveX(float dt, const std::vector<Block*>& blocks)
+// Tempi randomici per ogni nemico
+void Enemy::randomizeBehaviour()
 {
-    sprite.move(velocity.x * dt, 0.0f);
-    updateCollider();
-    
-    for(const auto& block : blocks)
-    {
-        if(collider.intersects(block->getBounds()))
-        {
-            float overlap = 0.f;
-            
-            if(velocity.x > 0) // Destra
-            {
-                overlap = (collider.left + collider.width) - block->getBounds().left;
-                sprite.move(-overlap, 0.f);
-                patrolDirection = -1.f; // Cambia direzione quando colpisce un muro
-            }
-            else if(velocity.x < 0) // Sinistra
-            {
-                overlap = block->getBounds().left + block->getBounds().width - collider.left;
-                sprite.move(overlap, 0.f);
-                patrolDirection = 1.f; // Cambia direzione quando colpisce un muro
-            }
-            
-            updateCollider();
-            velocity.x = 0;
-            break;
-        }
-    }
+    patrolChangeTime = randomFloat(1.0f, 4.0f);   // Tempo tra cambi direzione
+    attackDelay = randomFloat(0.2f, 1.0f);        // Tempo prima di attaccare
+    attackCooldown = randomFloat(1.0f, 2.5f);     // Cooldown tra attacchi
+    speed = randomFloat(60.0f, 120.0f);           // Velocità movimento
 }
 
-void Enemy::moveY(float dt, const std::vector<Block*>& blocks)
+// Riporta un'istanza del pool allo stato di un nemico appena creato,
+// senza ricaricare le texture
+void Enemy::reset(uint32_t id, bool localControl, float x, float y)
 {
-    sprite.move(0.0f, velocity.y * dt);
-    updateCollider();
-    
-    isGrounded = false;
-    
-    for(const auto& block : blocks)
-    {
-        if(collider.intersects(block->getBounds()))
-        {
-            float overlap = 0.f;
-            
-            if(velocity.y > 0) // Cadendo
-            {
-                overlap = (collider.top + collider.height) - block->getBounds().top;
-                sprite.move(0.f, -overlap);
-                isGrounded = true;
-            }
-            else if(velocity.y < 0) // Saltando
-            {
-                overlap = block->getBounds().top + block->getBounds().height - collider.top;
-                sprite.move(0.f, overlap);
-            }
-            
-            updateCollider();
-            velocity.y = 0;
-            break;
-        }
-    }
+    enemyId = id;
+    isLocallyControlled = localControl;
+    resetHealth();
+    randomizeBehaviour();
+
+    facingRight = true;
+    isAttacking = false;
+    attackCooldownTimer = 0.f;
+    patrolTimer = 0.f;
+    patrolDirection = 1.f;
+    seesPlayer = false;
+    attackDelayTimer = 0.f;
+    state = EnemyState::idle;
+
+    // Sprite come nel costruttore (la morte lo ruota e lo rende trasparente)
+    animations.play(animator, (*clips)[ClipId::Idle], true);
+    animations.setFacingRight(animator, true);
+    sprite.setRotation(0.f);
+    sprite.setColor(sf::Color::White);
+
+    kinematics.setVelocity(body, 0.f, 0.f);
+    kinematics.setGrounded(body, false);
+    setInitialPosition(x, y);
+}
+
+// Il nemico torna nel pool: il body resta allocato ma non viene più simulato
+void Enemy::deactivate()
+{
+    animations.pause(animator);
+    kinematics.setSimulated(body, false);
+    kinematics.setVelocity(body, 0.f, 0.f);
+}
+
+sf::FloatRect Enemy::getBounds() const
+{
+    return kinematics.getCollider(body);
+}
+
+sf::Vector2f Enemy::getPosition() const
+{
+    return kinematics.getPosition(body);
+}
+
+sf::Vector2f Enemy::getVelocity() const
+{
+    return kinematics.getVelocity(body);
+}
+
+bool Enemy::getIsGrounded() const
+{
+    return kinematics.isGrounded(body);
 }
 
 void Enemy::updateAI(float dt, const Scene& scene)
@@ -168,13 +134,17 @@ void Enemy::updateAI(float dt, const Scene& scene)
     Player* nearestPlayer = nullptr;
     float nearestDistance = 999999.f;
     
-    for(const auto& player : scene.getPlayers())
+    // Solo i player vicini: il raggio di visione è 60px in orizzontale e 30px in verticale
+    sf::Vector2f position = kinematics.getPosition(body);
+    sf::FloatRect senseArea(position.x - 60.f, position.y - 30.f, 120.f, 60.f);
+    
+    for(const auto& player : scene.queryPlayers(senseArea))
     {
         // Ignora player morti
         if(player->isDead()) continue;
         
-        float distance = std::abs(sprite.getPosition().x - player->getBounds().left);
-        float yDistance = std::abs(sprite.getPosition().y - player->getBounds().top);
+        float distance = std::abs(position.x - player->getBounds().left);
+        float yDistance = std::abs(position.y - player->getBounds().top);
         
         if(distance < 60.f && yDistance < 30.f)
         {
@@ -190,13 +160,13 @@ void Enemy::updateAI(float dt, const Scene& scene)
     // Gira verso il player più vicino
     if(nearestPlayer)
     {
-        facingRight = (nearestPlayer->getBounds().left > sprite.getPosition().x);
+        facingRight = (nearestPlayer->getBounds().left > position.x);
     }
     
     if(seesPlayer)
     {
         // Fermati quando vedi il player
-        velocity.x = 0.f;
+        kinematics.setVelocityX(body, 0.f);
         
         // Incrementa il timer di attesa
         attackDelayTimer += dt;
@@ -223,104 +193,64 @@ void Enemy::updateAI(float dt, const Scene& scene)
             patrolDirection *= -1.f;
         }
         
-        velocity.x = speed * patrolDirection;
+        kinematics.setVelocityX(body, speed * patrolDirection);
         facingRight = (patrolDirection > 0);
     }
 }
 
-void Enemy::updateAnimation(float dt)
+// Sceglie la clip in base allo stato: l'avanzamento dei frame lo fa l'Animator per tutti
+void Enemy::updateAnimation()
 {
-    static sf::Texture* lastTexture = nullptr;
-    static bool lastFacingRight = true;
-    
-    // Handle attack animation first
-    if(isAttacking)
+    if(isAttacking && animations.isFinished(animator))
     {
-        attackTimer += dt;
-        if(attackTimer >= attackFrameDuration)
-        {
-            attackTimer = 0.f;
-            attackFrame++;
-            if(attackFrame >= attack_textures.size())
-            {
-                isAttacking = false;
-                attackFrame = 0;
-                lastTexture = nullptr;
-            }
-        }
-        
-        if(isAttacking)
-        {
-            sprite.setTexture(attack_textures[attackFrame]);
-            sprite.setTextureRect(sf::IntRect(41, 24, 40, 30));
-            sprite.setScale(facingRight ? 1.f : -1.f, 1.f);
-            return;
-        }
+        isAttacking = false;
     }
     
-    // Determina texture
-    sf::Texture* texture = &idle_texture;
-    
-    if(velocity.x != 0.f && isGrounded)
+    ClipId clip = ClipId::Idle;
+    if(isAttacking)
     {
-        // Walking animation
-        animation_timer += dt;
-        if(animation_timer >= animation_speed)
-        {
-            animation_timer = 0.f;
-            current_animation_frame = (current_animation_frame + 1) % walk_textures.size();
-        }
-        texture = &walk_textures[current_animation_frame];
+        clip = ClipId::Attack;
     }
-    
-    // Cambia texture SOLO se necessario
-    if(texture != lastTexture || facingRight != lastFacingRight)
+    else if(kinematics.getVelocity(body).x != 0.f && kinematics.isGrounded(body))
     {
-        sprite.setTexture(*texture);
-        sprite.setTextureRect(sf::IntRect(41, 24, 15, 30));
-        
-        // Flip
-        sprite.setScale(facingRight ? 1.f : -1.f, 1.f);
-        
-        lastTexture = texture;
-        lastFacingRight = facingRight;
+        clip = ClipId::Walk;
     }
+    
+    animations.play(animator, (*clips)[clip]);
+    animations.setFacingRight(animator, facingRight);
 }
 
 Enemy::EnemyState Enemy::getState()
 {
     if(isAttacking)
         return EnemyState::attacking;
-    else if(velocity.x != 0.f)
+    else if(kinematics.getVelocity(body).x != 0.f)
         return EnemyState::walking;
     else
         return EnemyState::idle;
 }
 
-void Enemy::updateCollider()
-{
-    collider.left = sprite.getPosition().x - (collider.width / 2.f);
-    collider.top = sprite.getPosition().y - (collider.height / 2.f);
-}
-
 void Enemy::attack(const Scene& scene)
 {
+    sf::Vector2f position = kinematics.getPosition(body);
+    sf::FloatRect collider = kinematics.getCollider(body);
+    
     // Calculate attack hitbox position
     attackHitbox.width = 20.f;
     attackHitbox.height = 20.f;
     if(facingRight)
     {
-        attackHitbox.left = sprite.getPosition().x + collider.width / 2.f;
-        attackHitbox.top = sprite.getPosition().y - 10.f;
+        attackHitbox.left = position.x + collider.width / 2.f;
+        attackHitbox.top = position.y - 10.f;
     }
     else
     {
-        attackHitbox.left = sprite.getPosition().x - collider.width / 2.f - 20.f;
-        attackHitbox.top = sprite.getPosition().y - 10.f;
+        attackHitbox.left = position.x - collider.width / 2.f - 20.f;
+        attackHitbox.top = position.y - 10.f;
     }
     
     // Controlla se l'attacco colpisce un player
-    for(const auto& player : scene.getPlayers())
+    for(const auto& player : scene.queryPlayers(attackHitbox))
     {
         if(attackHitbox.intersects(player->getBounds()))
         {
@@ -329,7 +259,7 @@ void Enemy::attack(const Scene& scene)
             {
                 player->takeDamage(10.f);
             }
-            else if (isLocallyControlled && NetworkClient::getInstance()->isConnected())
+            else if (isLocallyControlled && network.isConnected())
             {
                 // Se siamo l'host e il player è remoto, invia pacchetto danno
                 // Il client riceverà e applicherà il danno
@@ -340,7 +270,7 @@ void Enemy::attack(const Scene& scene)
                 damagePacket.damage = 10.f;
                 damagePacket.currentHealth = player->getHealth() - 10.f; // Stima
                 
-                NetworkClient::getInstance()->sendPacket(damagePacket);
+                network.sendPacket(damagePacket);
             }
         }
     }
@@ -353,8 +283,7 @@ void Enemy::setAttackAnimation()
     if(!isAttacking)
     {
         isAttacking = true;
-        attackFrame = 0;
-        attackTimer = 0.f;
+        animations.play(animator, (*clips)[ClipId::Attack], true);
     }
 }
 
@@ -362,51 +291,67 @@ void Enemy::update(const Scene& scene)
 {
     float dt = scene.getDt();
     
+    // La fisica muove tutti i nemici vivi: quelli remoti proseguono con l'ultima velocità
+    // ricevuta fra uno snapshot e l'altro (il tick di rete è più lento della simulazione)
+    kinematics.setSimulated(body, !dying);
+    
     // Gestione morte
     if (dying)
     {
         sprite.setRotation(90.f);
+        animations.pause(animator); // Resta sull'ultimo frame mentre svanisce
         updateDeath(dt);
         return;
     }
     
+    if (isLocallyControlled)
+    {
+        updateAI(dt, scene);
+    }
+}
+
+// Dopo lo step della fisica: reazione ai muri, animazione e sync di rete
+void Enemy::lateUpdate(const Scene& scene)
+{
+    sf::Vector2f position = kinematics.getPosition(body);
+    sprite.setPosition(position);
+    
+    if (dying) return;
+    
     // Se non sono il controller locale, solo aggiorna animazione
     if (!isLocallyControlled)
     {
-        updateAnimation(dt);
+        updateAnimation();
         return;
     }
     
-    auto blocks = scene.getBlocks();
+    // Cambia direzione quando colpisce un muro
+    if (kinematics.getBlockedX(body) > 0)
+        patrolDirection = -1.f;
+    else if (kinematics.getBlockedX(body) < 0)
+        patrolDirection = 1.f;
     
-    updateAI(dt, scene);
-    apply_gravity(dt);
-    moveX(dt, blocks);
-    moveY(dt, blocks);
-    updateAnimation(dt);
-    
-    // Invia aggiornamento al server
-    if (NetworkClient::getInstance()->isConnected())
-    {
-        PacketEnemyUpdate packet;
-        packet.header.type = PacketType::ENEMY_UPDATE;
-        packet.header.packetSize = sizeof(PacketEnemyUpdate);
-        packet.enemyId = enemyId;
-        packet.x = sprite.getPosition().x;
-        packet.y = sprite.getPosition().y;
-        packet.velocityX = velocity.x;
-        packet.velocityY = velocity.y;
-        packet.isFacingRight = facingRight ? 1 : 0;
-        packet.isGrounded = isGrounded ? 1 : 0;
-        packet.isAttacking = isAttacking ? 1 : 0;
-        packet.padding = 0;
-        packet.currentHealth = currentHealth;
-        
-        NetworkClient::getInstance()->sendPacket(packet);
-    }
+    updateAnimation();
+    // Lo stato va in rete con lo snapshot del tick di rete (Scene::sendEnemySnapshots)
 }
 
-void Enemy::draw(sf::RenderWindow& window)
+void Enemy::captureNetState(EnemyNetState& out) const
+{
+    sf::Vector2f position = kinematics.getPosition(body);
+    sf::Vector2f velocity = kinematics.getVelocity(body);
+    out.enemyId = enemyId;
+    out.x = position.x;
+    out.y = position.y;
+    out.velocityX = velocity.x;
+    out.velocityY = velocity.y;
+    out.isFacingRight = facingRight ? 1 : 0;
+    out.isGrounded = kinematics.isGrounded(body) ? 1 : 0;
+    out.isAttacking = isAttacking ? 1 : 0;
+    out.padding = 0;
+    out.currentHealth = currentHealth;
+}
+
+void Enemy::applyDeathFade()
 {
     // Fade out durante la morte
     if (dying)
@@ -414,54 +359,24 @@ void Enemy::draw(sf::RenderWindow& window)
         float alpha = 255.f * (1.f - getDeathProgress());
         sprite.setColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(alpha)));
     }
-    
-    window.draw(sprite);
-    
-    // Non disegnare health bar se sta morendo
-    if (dying) return;
-    
-    // Health bar
-    float barWidth = 30.f;
-    float barHeight = 4.f;
-    float barOffsetY = -20.f;
-    
-    // Background
-    sf::RectangleShape healthBarBg;
-    healthBarBg.setSize(sf::Vector2f(barWidth, barHeight));
-    healthBarBg.setPosition(sprite.getPosition().x - barWidth / 2.f, 
-                            sprite.getPosition().y + barOffsetY);
-    healthBarBg.setFillColor(sf::Color(60, 60, 60));
-    healthBarBg.setOutlineColor(sf::Color::Black);
-    healthBarBg.setOutlineThickness(1.f);
-    window.draw(healthBarBg);
-    
-    // Foreground
-    sf::RectangleShape healthBar;
-    float healthPercent = getHealthPercent();
-    healthBar.setSize(sf::Vector2f(barWidth * healthPercent, barHeight));
-    healthBar.setPosition(sprite.getPosition().x - barWidth / 2.f, 
-                          sprite.getPosition().y + barOffsetY);
-    
-    if (healthPercent > 0.6f)
-        healthBar.setFillColor(sf::Color(50, 205, 50));
-    else if (healthPercent > 0.3f)
-        healthBar.setFillColor(sf::Color(255, 165, 0));
-    else
-        healthBar.setFillColor(sf::Color(220, 20, 60));
-    
-    window.draw(healthBar);
-    
-    // Draw attack hitbox when attacking (debug)
-    if(isAttacking)
-    {
-        sf::RectangleShape hitboxRect;
-        hitboxRect.setPosition(attackHitbox.left, attackHitbox.top);
-        hitboxRect.setSize(sf::Vector2f(attackHitbox.width, attackHitbox.height));
-        hitboxRect.setFillColor(sf::Color(255, 0, 0, 100));
-        hitboxRect.setOutlineColor(sf::Color::Red);
-        hitboxRect.setOutlineThickness(2.f);
-        window.draw(hitboxRect);
-    }
+}
+
+// Stato da disegnare, copiato nel RenderSnapshot (il render non tocca mai l'entità)
+void Enemy::captureRender(ActorSnapshot& out)
+{
+    applyDeathFade();
+    out.texture = sprite.getTexture();
+    out.textureRect = sprite.getTextureRect();
+    out.origin = sprite.getOrigin();
+    out.previousPosition = kinematics.getPreviousPosition(body);
+    out.position = kinematics.getPosition(body);
+    out.scaleX = sprite.getScale().x;
+    out.rotation = sprite.getRotation();
+    out.color = sprite.getColor();
+    out.healthPercent = getHealthPercent();
+    out.showHealthBar = !dying;
+    out.showHitbox = isAttacking && !dying;
+    out.hitbox = attackHitbox;
 }
 
 void Enemy::syncFromNetwork(float x, float y, float velX, float velY, 
@@ -470,12 +385,11 @@ void Enemy::syncFromNetwork(float x, float y, float velX, float velY,
     if (isLocallyControlled)
         return; // Non sincronizzare se siamo noi a controllarlo
     
+    kinematics.setPosition(body, x, y);
     sprite.setPosition(x, y);
-    updateCollider();
-    velocity.x = velX;
-    velocity.y = velY;
+    kinematics.setVelocity(body, velX, velY);
     facingRight = faceRight;
-    isGrounded = grounded;
+    kinematics.setGrounded(body, grounded);
     
     // Gestione animazione attacco
     if (attacking && !isAttacking)
@@ -484,6 +398,7 @@ void Enemy::syncFromNetwork(float x, float y, float velX, float velY,
     }
     
     // Sincronizza la salute
+    if (health < currentHealth && !dying) spawnHitEffect();
     currentHealth = health;
     if (currentHealth <= 0.f && !dying)
     {
@@ -495,6 +410,6 @@ void Enemy::syncFromNetwork(float x, float y, float velX, float velY,
 
 void Enemy::setInitialPosition(float x, float y)
 {
+    kinematics.teleport(body, x, y);
     sprite.setPosition(x, y);
-    updateCollider();
 }
\ No newline at end of file
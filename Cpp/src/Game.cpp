@@ -2,6 +2,10 @@
 
 #include "Game.h"
 #include "Scene.h"
+#include "TextureCache.h"
+#include "CharacterAtlas.h"
+#include "ParticleSystem.h"
+#include "NetworkClient.h"
 
 // Inizializzazione membro statico
 Game* Game::instance = nullptr;
@@ -19,6 +23,20 @@ Game* Game::getInstance(sf::RenderWindow* window)
     return instance; 
 }
 
+Game* Game::createHeadless()
+{
+    if (instance == nullptr)
+    {
+        // Nessuna GPU: le texture non vengono caricate (solo le dimensioni per le collisioni)
+        // e gli effetti non servono a nessuno
+        TextureCache::getInstance()->setHeadless(true);
+        CharacterAtlas::getInstance()->setHeadless(true);
+        ParticleSystem::getInstance()->setEnabled(false);
+        instance = new Game(nullptr);
+    }
+    return instance;
+}
+
 void Game::destroyInstance()
 {
     delete instance;
@@ -27,6 +45,11 @@ void Game::destroyInstance()
 
 Game::Game(sf::RenderWindow* window) : window(window), currentScene(nullptr), enemiesToDefeat(0), gameWon(false), levelComplete(false), gameOver(false), currentLevel(1), isHost(false)
 {
+    isWindowFocused = false;
+    
+    // Senza finestra non c'è HUD da disegnare
+    if (window == nullptr) return;
+    
     // Carica il font per l'UI (prova diversi percorsi)
     bool fontLoaded = false;
     
@@ -74,7 +97,6 @@ Game::Game(sf::RenderWindow* window) : window(window), currentScene(nullptr), en
     levelText.setOutlineColor(sf::Color::White);
     levelText.setOutlineThickness(2.f);
     levelText.setPosition(10.f, 40.f);
-    levelText.setString("Livello: 1");
     
     // Setup testo vittoria
     gameOverText.setFont(gameFont);
@@ -82,8 +104,6 @@ Game::Game(sf::RenderWindow* window) : window(window), currentScene(nullptr), en
     gameOverText.setFillColor(sf::Color::Green);
     gameOverText.setOutlineColor(sf::Color::Black);
     gameOverText.setOutlineThickness(3.f);
-    gameOverText.setString("HAI VINTO!");
-    gameOverText.setPosition(280.f, 250.f);
     
     // Setup testo restart
     restartText.setFont(gameFont);
@@ -101,6 +121,7 @@ Game::Game(sf::RenderWindow* window) : window(window), currentScene(nullptr), en
     hostText.setOutlineColor(sf::Color::Black);
     hostText.setOutlineThickness(1.f);
     hostText.setPosition(650.f, 10.f);
+    hostText.setString("[HOST]");
 }
 
 Game::~Game()
@@ -111,14 +132,18 @@ Game::~Game()
 
 void Game::update(float dt)
 {
+    if (currentScene == nullptr) return;
+
     // Se il gioco è finito (vinto o perso), non aggiornare più
-    if (gameWon || gameOver) return;
-    
-    if (currentScene != nullptr) 
+    if (!gameWon && !gameOver)
     {
         currentScene->setDt(dt);
         currentScene->update();
     }
+
+    // Tutti i pacchetti del tick (e quelli accodati fuori dall'update, es. spawn dei nemici)
+    // partono insieme in un'unica scrittura
+    currentScene->getNetwork().flush();
 }
 
 void Game::setScene(Scene* newScene)
@@ -128,6 +153,11 @@ void Game::setScene(Scene* newScene)
         delete currentScene;
     }
     currentScene = newScene;
+    // setIsHost() può essere stato chiamato prima di avere una scena
+    if (currentScene)
+    {
+        currentScene->setIsHost(isHost);
+    }
 }
 
 void Game::setLocalPlayerId(int id) {
@@ -152,12 +182,10 @@ sf::RenderWindow& Game::getWindow() const {
 
 void Game::setEnemiesToDefeat(int count) {
     enemiesToDefeat = count;
-    enemyCountText.setString("Nemici: " + std::to_string(enemiesToDefeat));
 }
 
 void Game::incrementEnemiesToDefeat() {
     enemiesToDefeat++;
-    enemyCountText.setString("Nemici: " + std::to_string(enemiesToDefeat));
 }
 
 int Game::getEnemiesToDefeat() const {
@@ -167,7 +195,6 @@ int Game::getEnemiesToDefeat() const {
 void Game::enemyDefeated() {
     if (enemiesToDefeat > 0) {
         enemiesToDefeat--;
-        enemyCountText.setString("Nemici: " + std::to_string(enemiesToDefeat));
         
         if (enemiesToDefeat == 0) {
             levelComplete = true;
@@ -180,25 +207,59 @@ bool Game::isGameWon() const {
     return gameWon;
 }
 
+HudState Game::getHudState() const {
+    HudState hud;
+    hud.enemiesToDefeat = enemiesToDefeat;
+    hud.level = currentLevel;
+    hud.isHost = isHost;
+    hud.gameOver = gameOver;
+    hud.gameWon = gameWon;
+    return hud;
+}
+
+// Aggiorna stringhe e stile dei testi: chiamata da drawHud solo se lo stato è cambiato
+void Game::refreshHud(const HudState& hud) {
+    enemyCountText.setString("Nemici: " + std::to_string(hud.enemiesToDefeat));
+    levelText.setString("Livello: " + std::to_string(hud.level));
+    
+    if (hud.gameOver) {
+        gameOverText.setString("GAME OVER");
+        gameOverText.setFillColor(sf::Color::Red);
+        gameOverText.setPosition(270.f, 250.f);
+    }
+    else if (hud.gameWon) {
+        gameOverText.setString("HAI VINTO!");
+        gameOverText.setFillColor(sf::Color::Green);
+        gameOverText.setPosition(280.f, 250.f);
+    }
+    
+    drawnHud = hud;
+}
+
 void Game::drawUI() {
-    window->draw(enemyCountText);
-    window->draw(levelText);
+    drawHud(*window, getHudState());
+}
+
+// Usa solo 'hud' e i testi: in modalità threaded la chiama il thread di render
+void Game::drawHud(sf::RenderTarget& target, const HudState& hud) {
+    if (hud != drawnHud) {
+        refreshHud(hud);
+    }
+    
+    target.draw(enemyCountText);
+    target.draw(levelText);
     
     // Mostra se siamo host
-    if (isHost) {
-        hostText.setString("[HOST]");
-        window->draw(hostText);
+    if (hud.isHost) {
+        target.draw(hostText);
     }
     
-    if (gameOver) {
-        gameOverText.setString("GAME OVER");
-        gameOverText.setFillColor(sf::Color::Red);
-        gameOverText.setPosition(270.f, 250.f);
-        window->draw(gameOverText);
-        window->draw(restartText);
+    if (hud.gameOver) {
+        target.draw(gameOverText);
+        target.draw(restartText);
     }
-    else if (gameWon) {
-        window->draw(gameOverText);
+    else if (hud.gameWon) {
+        target.draw(gameOverText);
     }
 }
 
@@ -209,7 +270,6 @@ int Game::getCurrentLevel() const {
 void Game::nextLevel() {
     currentLevel++;
     levelComplete = false;
-    levelText.setString("Livello: " + std::to_string(currentLevel));
     std::cout << "Inizia il LIVELLO " << currentLevel << "!" << std::endl;
 }
 
@@ -222,6 +282,8 @@ void Game::resetLevelComplete() {
 }
 
 void Game::setGameOver() {
+    // Chiamata ad ogni tick finché il player locale è morto: agisci solo la prima volta
+    if (gameOver) return;
     gameOver = true;
     std::cout << "GAME OVER! Hai raggiunto il livello " << currentLevel << std::endl;
 }
@@ -235,7 +297,6 @@ void Game::restartGame() {
     gameWon = false;
     levelComplete = false;
     currentLevel = 1;
-    levelText.setString("Livello: 1");
     std::cout << "Gioco riavviato!" << std::endl;
 }
 
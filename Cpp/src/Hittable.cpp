@@ -1,4 +1,5 @@
 #include "Hittable.h"
+#include "ParticleSystem.h"
 
 Hittable::Hittable(float maxHealth)
     : maxHealth(maxHealth), currentHealth(maxHealth), dead(false),
@@ -10,6 +11,7 @@ void Hittable::takeDamage(float amount)
     if (dead || dying) return;
     
     currentHealth -= amount;
+    spawnHitEffect();
     if (currentHealth <= 0.f)
     {
         currentHealth = 0.f;
@@ -50,7 +52,13 @@ bool Hittable::updateDeath(float dt)
     return false;
 }
 
+void Hittable::spawnHitEffect()
+{
+    ParticleSystem::getInstance()->emit(EffectType::HitSpark, getPosition());
+}
+
 void Hittable::onDeath()
 {
-    // Override nelle classi derivate per comportamento specifico
+    // Le classi derivate che fanno override richiamino questa per lo sbuffo di morte
+    ParticleSystem::getInstance()->emit(EffectType::DeathPuff, getPosition());
 }
@@ -0,0 +1,159 @@
+#include "Kinematics.h"
+#include "Scene.h"
+#include "SpatialGrid.h"
+
+uint32_t Kinematics::createBody(float width, float height, float gravityValue)
+{
+    uint32_t body;
+    if (!freeList.empty())
+    {
+        body = freeList.back();
+        freeList.pop_back();
+    }
+    else
+    {
+        body = static_cast<uint32_t>(posX.size());
+        posX.push_back(0.f);
+        posY.push_back(0.f);
+        prevX.push_back(0.f);
+        prevY.push_back(0.f);
+        velX.push_back(0.f);
+        velY.push_back(0.f);
+        halfW.push_back(0.f);
+        halfH.push_back(0.f);
+        gravity.push_back(0.f);
+        simMask.push_back(0.f);
+        grounded.push_back(0);
+        blockedX.push_back(0);
+        inUse.push_back(0);
+    }
+
+    posX[body] = 0.f;
+    posY[body] = 0.f;
+    prevX[body] = 0.f;
+    prevY[body] = 0.f;
+    velX[body] = 0.f;
+    velY[body] = 0.f;
+    halfW[body] = width / 2.f;
+    halfH[body] = height / 2.f;
+    gravity[body] = gravityValue;
+    simMask[body] = 0.f;
+    grounded[body] = 0;
+    blockedX[body] = 0;
+    inUse[body] = 1;
+    return body;
+}
+
+void Kinematics::destroyBody(uint32_t body)
+{
+    if (body >= inUse.size() || !inUse[body]) return;
+    inUse[body] = 0;
+    simMask[body] = 0.f; // i body liberi restano negli array ma non si muovono
+    freeList.push_back(body);
+}
+
+void Kinematics::beginTick()
+{
+    prevX = posX;
+    prevY = posY;
+}
+
+void Kinematics::step(float dt, const Scene& scene)
+{
+    const std::size_t count = posX.size();
+    float* vx = velX.data();
+    float* vy = velY.data();
+    float* px = posX.data();
+    float* py = posY.data();
+    const float* g = gravity.data();
+    const float* mask = simMask.data();
+
+    // 1. Gravità (tutti i body in un'unica passata)
+    for (std::size_t i = 0; i < count; i++)
+    {
+        vy[i] += g[i] * dt * mask[i];
+    }
+
+    // 2. Asse X: integra e risolvi le collisioni
+    for (std::size_t i = 0; i < count; i++)
+    {
+        px[i] += vx[i] * dt * mask[i];
+    }
+    for (std::size_t i = 0; i < count; i++)
+    {
+        blockedX[i] = 0;
+        if (mask[i] != 0.f)
+            resolveX(static_cast<uint32_t>(i), vx[i] * dt, scene);
+    }
+
+    // 3. Asse Y: integra e risolvi le collisioni
+    for (std::size_t i = 0; i < count; i++)
+    {
+        py[i] += vy[i] * dt * mask[i];
+    }
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (mask[i] != 0.f)
+            resolveY(static_cast<uint32_t>(i), vy[i] * dt, scene);
+    }
+}
+
+void Kinematics::resolveX(uint32_t body, float dx, const Scene& scene)
+{
+    sf::FloatRect collider = getCollider(body);
+    sf::FloatRect previous = collider;
+    previous.left -= dx;
+
+    // Solo i rettangoli solidi vicini all'AABB spazzato durante lo spostamento
+    for (const auto& solid : scene.querySolids(unionRect(previous, collider)))
+    {
+        if (collider.intersects(solid))
+        {
+            if (velX[body] > 0) // Destra
+            {
+                // Il lato destro del collider è oltre il lato sinistro del solido
+                posX[body] -= (collider.left + collider.width) - solid.left;
+                blockedX[body] = 1;
+            }
+            else if (velX[body] < 0) // Sinistra
+            {
+                // Il lato sinistro del collider è oltre il lato destro del solido
+                posX[body] += solid.left + solid.width - collider.left;
+                blockedX[body] = -1;
+            }
+
+            velX[body] = 0.f;
+            break;
+        }
+    }
+}
+
+void Kinematics::resolveY(uint32_t body, float dy, const Scene& scene)
+{
+    sf::FloatRect collider = getCollider(body);
+    sf::FloatRect previous = collider;
+    previous.top -= dy;
+
+    grounded[body] = 0;
+
+    for (const auto& solid : scene.querySolids(unionRect(previous, collider)))
+    {
+        if (collider.intersects(solid))
+        {
+            if (velY[body] > 0) // Cadendo
+            {
+                // Il fondo del collider è oltre la cima del solido
+                posY[body] -= (collider.top + collider.height) - solid.top;
+                grounded[body] = 1;
+            }
+            else if (velY[body] < 0) // Saltando
+            {
+                // La cima del collider è oltre il fondo del solido
+                posY[body] += solid.top + solid.height - collider.top;
+            }
+
+            velY[body] = 0.f;
+            break;
+        }
+    }
+}
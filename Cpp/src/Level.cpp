@@ -0,0 +1,117 @@
+#include "Level.h"
+#include "Scene.h"
+#include "Block.h"
+#include "ParticleSystem.h"
+#include "NetworkClient.h"
+#include "NetMessages.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+void Level::build(Scene& scene)
+{
+    // Funzione helper (lambda) per creare una fila di blocchi velocemente
+    auto createPlatform = [&](float startX, float startY, int numBlocks) {
+        for(int i = 0; i < numBlocks; i++) {
+            scene.addEntity(std::make_unique<Block>(
+                startX + (i * 15.0f),  // X: Si sposta di 15px per ogni blocco
+                startY,                // Y: Rimane fissa per la piattaforma
+                "assets/pp1/Blocks/block1.png"
+            ));
+        }
+    };
+    
+    // Funzione helper per creare muri verticali
+    auto createWall = [&](float startX, float startY, int numBlocks) {
+        for(int i = 0; i < numBlocks; i++) {
+            scene.addEntity(std::make_unique<Block>(
+                startX,
+                startY + (i * 15.0f),  // Y: Si sposta di 15px per ogni blocco
+                "assets/pp1/Blocks/block1.png"
+            ));
+        }
+    };
+    
+    // Piattaforme di gioco
+    createPlatform(100.0f, 450.0f, 40);
+    createPlatform(130.0f, 325.0f, 10);
+    createPlatform(520.0f, 325.0f, 10);
+    createPlatform(340.0f, 200.0f, 8);
+    
+    // -----------------------------------------------------------
+    // BLOCCHI AI BORDI (per evitare di cadere fuori mappa)
+    // -----------------------------------------------------------
+    // Pavimento in basso (tutta la larghezza)
+    createPlatform(0.0f, 550.0f, 54);
+    // Muro sinistro
+    createWall(0.0f, 0.0f, 40);
+    // Muro destro
+    createWall(785.0f, 0.0f, 40);
+    // Soffitto in alto
+    createPlatform(0.0f, 0.0f, 54);
+
+    // Effetti ambientali in loop: pozze di lava sul pavimento e un portale sulla piattaforma alta
+    ParticleSystem* particles = ParticleSystem::getInstance();
+    for (float lavaX : { 40.0f, 56.0f, 744.0f, 760.0f })
+    {
+        particles->addLoop(EffectType::Lava, sf::Vector2f(lavaX, 550.0f - 9.5f));
+    }
+    particles->addLoop(EffectType::Portal, sf::Vector2f(400.0f, 200.0f - 21.0f));
+}
+
+const std::vector<SpawnPoint>& Level::getEnemySpawnPoints()
+{
+    static const std::vector<SpawnPoint> spawnPoints = {
+        {150.0f, 420.0f},   // Piattaforma principale sinistra
+        {300.0f, 420.0f},   // Piattaforma principale centro-sinistra
+        {450.0f, 420.0f},   // Piattaforma principale centro-destra
+        {600.0f, 420.0f},   // Piattaforma principale destra
+        {180.0f, 295.0f},   // Piattaforma sinistra alta
+        {570.0f, 295.0f},   // Piattaforma destra alta
+        {380.0f, 170.0f},   // Piattaforma centrale più alta
+    };
+    return spawnPoints;
+}
+
+int Level::spawnEnemies(Scene& scene, int level)
+{
+    const std::vector<SpawnPoint>& spawnPoints = getEnemySpawnPoints();
+    NetworkClient& network = scene.getNetwork();
+
+    // Numero base di nemici + 2 per ogni livello
+    int numEnemies = 3 + (level * 2);
+    
+    // Tetto massimo di nemici per livello
+    if (numEnemies > MaxEnemiesPerLevel) numEnemies = MaxEnemiesPerLevel;
+    
+    for (int i = 0; i < numEnemies; i++) {
+        // Scegli un punto di spawn random
+        int spawnIndex = std::rand() % spawnPoints.size();
+        SpawnPoint spawn = spawnPoints[spawnIndex];
+        
+        // Aggiungi una piccola variazione casuale alla X
+        float offsetX = static_cast<float>((std::rand() % 40) - 20);
+        
+        uint32_t enemyId = static_cast<uint32_t>(i + 1);
+        float spawnX = spawn.x + offsetX;
+        float spawnY = spawn.y;
+        
+        // Riusa un nemico del pool alla posizione iniziale (Host controlla sempre)
+        scene.spawnEnemy(enemyId, true, spawnX, spawnY);
+        
+        // Se online, invia pacchetto spawn ai client
+        if (network.isConnected()) {
+            PacketEnemySpawn spawnPacket;
+            spawnPacket.header.type = PacketType::ENEMY_SPAWN;
+            spawnPacket.header.packetSize = sizeof(PacketEnemySpawn);
+            spawnPacket.enemyId = enemyId;
+            spawnPacket.x = spawnX;
+            spawnPacket.y = spawnY;
+            spawnPacket.maxHealth = 100.f;
+            
+            network.sendPacket(spawnPacket);
+            std::cout << "Inviato spawn nemico ID " << enemyId << " a (" << spawnX << ", " << spawnY << ")" << std::endl;
+        }
+    }
+    return numEnemies;
+}
@@ -0,0 +1,60 @@
+#include "OverlayRenderer.h"
+
+OverlayRenderer::OverlayRenderer() : vertices(sf::Quads) {}
+
+void OverlayRenderer::clear()
+{
+    vertices.clear();
+}
+
+void OverlayRenderer::addQuad(float left, float top, float width, float height, const sf::Color& color)
+{
+    vertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+    vertices.append(sf::Vertex(sf::Vector2f(left + width, top), color));
+    vertices.append(sf::Vertex(sf::Vector2f(left + width, top + height), color));
+    vertices.append(sf::Vertex(sf::Vector2f(left, top + height), color));
+}
+
+void OverlayRenderer::addRect(const sf::FloatRect& rect, const sf::Color& fill,
+                              const sf::Color& outline, float outlineThickness)
+{
+    addQuad(rect.left, rect.top, rect.width, rect.height, fill);
+
+    if (outlineThickness <= 0.f) return;
+
+    // Bordo esterno: sopra e sotto a tutta larghezza, lati solo all'altezza del rettangolo
+    float t = outlineThickness;
+    addQuad(rect.left - t, rect.top - t, rect.width + t * 2.f, t, outline);
+    addQuad(rect.left - t, rect.top + rect.height, rect.width + t * 2.f, t, outline);
+    addQuad(rect.left - t, rect.top, t, rect.height, outline);
+    addQuad(rect.left + rect.width, rect.top, t, rect.height, outline);
+}
+
+void OverlayRenderer::addHealthBar(const sf::Vector2f& anchor, float healthPercent)
+{
+    float barWidth = 30.f;
+    float barHeight = 4.f;
+    float barOffsetY = -20.f; // Sopra la testa
+
+    float left = anchor.x - barWidth / 2.f;
+    float top = anchor.y + barOffsetY;
+
+    // Background
+    addRect(sf::FloatRect(left, top, barWidth, barHeight), sf::Color(60, 60, 60), sf::Color::Black, 1.f);
+
+    // Foreground (verde -> arancione -> rosso in base alla salute)
+    sf::Color color;
+    if (healthPercent > 0.6f)
+        color = sf::Color(50, 205, 50); // Verde
+    else if (healthPercent > 0.3f)
+        color = sf::Color(255, 165, 0); // Arancione
+    else
+        color = sf::Color(220, 20, 60); // Rosso
+    addQuad(left, top, barWidth * healthPercent, barHeight, color);
+}
+
+void OverlayRenderer::draw(sf::RenderTarget& target) const
+{
+    if (vertices.getVertexCount() > 0)
+        target.draw(vertices);
+}
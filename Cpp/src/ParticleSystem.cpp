@@ -0,0 +1,198 @@
+#include "ParticleSystem.h"
+#include "CharacterAtlas.h"
+#include "RenderSnapshot.h"
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+
+// Inizializzazione membro statico
+ParticleSystem* ParticleSystem::instance = nullptr;
+
+ParticleSystem* ParticleSystem::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new ParticleSystem();
+    }
+    return instance;
+}
+
+void ParticleSystem::destroyInstance()
+{
+    delete instance;
+    instance = nullptr;
+}
+
+// Helper per generare float random in un range
+static float randomFloat(float min, float max)
+{
+    return min + static_cast<float>(std::rand()) / (static_cast<float>(RAND_MAX / (max - min)));
+}
+
+ParticleSystem::ParticleSystem() : assetsLoaded(false), activeCount(0), enabled(true)
+{
+    // Tutta la memoria viene allocata qui, una volta sola
+    posX.resize(Capacity);
+    posY.resize(Capacity);
+    velX.resize(Capacity);
+    velY.resize(Capacity);
+    age.resize(Capacity);
+    lifetime.resize(Capacity);
+    gravity.resize(Capacity);
+    type.resize(Capacity);
+}
+
+// I frame vengono caricati al primo utilizzo (serve il contesto grafico)
+void ParticleSystem::loadAssets()
+{
+    CharacterAtlas* atlas = CharacterAtlas::getInstance();
+
+    auto setup = [&](EffectType effect, const std::vector<std::string>& names,
+                     const sf::IntRect& crop, float frameDuration, bool loop) {
+        EffectClip& clip = clips[static_cast<int>(effect)];
+        for (const auto& name : names)
+        {
+            clip.frames.push_back(&atlas->getFrame("miscellaneous", name));
+        }
+        clip.crop = crop;
+        clip.frameDuration = frameDuration;
+        clip.loop = loop;
+    };
+
+    setup(EffectType::HitSpark, { "effect_1", "effect_2", "effect_3", "effect_4", "effect_5" },
+          sf::IntRect(34, 16, 30, 26), 0.05f, false);
+    setup(EffectType::DeathPuff, { "effect_3", "effect_4", "effect_5" },
+          sf::IntRect(34, 16, 30, 26), 0.15f, false);
+    setup(EffectType::Lava, { "Lava1", "Lava2", "Lava3" }, sf::IntRect(40, 16, 16, 19), 0.2f, true);
+    setup(EffectType::Portal, { "Portal1", "Portal2", "Portal3", "Portal4" }, sf::IntRect(35, 12, 26, 42), 0.12f, true);
+
+    assetsLoaded = true;
+}
+
+bool ParticleSystem::spawn(EffectType effect, float x, float y, float vx, float vy, float g, float life)
+{
+    if (!enabled || activeCount == Capacity) return false; // pool pieno: l'effetto viene scartato
+
+    std::size_t i = activeCount++;
+    posX[i] = x;
+    posY[i] = y;
+    velX[i] = vx;
+    velY[i] = vy;
+    gravity[i] = g;
+    age[i] = 0.f;
+    lifetime[i] = life;
+    type[i] = static_cast<uint8_t>(effect);
+    return true;
+}
+
+void ParticleSystem::emit(EffectType effect, const sf::Vector2f& position)
+{
+    if (!enabled) return;
+    if (!assetsLoaded) loadAssets();
+    const EffectClip& clip = clips[static_cast<int>(effect)];
+    float duration = clip.frameDuration * clip.frames.size();
+
+    if (effect == EffectType::DeathPuff)
+    {
+        // Qualche sbuffo che si allarga e ricade
+        for (int n = 0; n < 6; n++)
+        {
+            spawn(effect, position.x, position.y,
+                  randomFloat(-60.f, 60.f), randomFloat(-90.f, -20.f), 150.f, duration);
+        }
+        return;
+    }
+
+    spawn(effect, position.x, position.y, 0.f, 0.f, 0.f, duration);
+}
+
+void ParticleSystem::addLoop(EffectType effect, const sf::Vector2f& position)
+{
+    if (!enabled) return;
+    if (!assetsLoaded) loadAssets();
+    spawn(effect, position.x, position.y, 0.f, 0.f, 0.f, -1.f);
+}
+
+void ParticleSystem::update(float dt)
+{
+    std::size_t count = activeCount;
+
+    // Integrazione: passate lineari sugli array
+    for (std::size_t i = 0; i < count; i++)
+    {
+        velY[i] += gravity[i] * dt;
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+        age[i] += dt;
+    }
+
+    // Gli effetti in loop non scadono: l'età si riavvolge sulla durata della clip,
+    // così non cresce all'infinito (e non perde precisione nel calcolo del frame)
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (lifetime[i] >= 0.f) continue;
+        const EffectClip& clip = clips[type[i]];
+        float length = clip.frameDuration * clip.frames.size();
+        if (length > 0.f && age[i] >= length)
+            age[i] = std::fmod(age[i], length);
+    }
+
+    // Rimozione delle particelle scadute (swap con l'ultima viva)
+    std::size_t i = 0;
+    while (i < activeCount)
+    {
+        if (lifetime[i] >= 0.f && age[i] >= lifetime[i])
+        {
+            std::size_t last = --activeCount;
+            posX[i] = posX[last];
+            posY[i] = posY[last];
+            velX[i] = velX[last];
+            velY[i] = velY[last];
+            gravity[i] = gravity[last];
+            age[i] = age[last];
+            lifetime[i] = lifetime[last];
+            type[i] = type[last];
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void ParticleSystem::capture(std::vector<EffectQuad>& out) const
+{
+    for (std::size_t i = 0; i < activeCount; i++)
+    {
+        const EffectClip& clip = clips[type[i]];
+        if (clip.frames.empty()) continue;
+
+        std::size_t frame = static_cast<std::size_t>(age[i] / clip.frameDuration);
+        frame = clip.loop ? frame % clip.frames.size() : std::min(frame, clip.frames.size() - 1);
+        const AtlasFrame* atlasFrame = clip.frames[frame];
+
+        float width = static_cast<float>(clip.crop.width);
+        float height = static_cast<float>(clip.crop.height);
+
+        EffectQuad quad;
+        quad.texture = atlasFrame->texture;
+        quad.bounds = sf::FloatRect(posX[i] - width / 2.f, posY[i] - height / 2.f, width, height);
+        quad.rect = atlasFrame->crop(clip.crop);
+        // Gli effetti a tempo svaniscono verso la fine
+        if (lifetime[i] > 0.f)
+            quad.color.a = static_cast<sf::Uint8>(255.f * (1.f - std::min(age[i] / lifetime[i], 1.f)));
+        out.push_back(quad);
+    }
+}
+
+void ParticleSystem::clear()
+{
+    activeCount = 0;
+}
+
+void ParticleSystem::setEnabled(bool value)
+{
+    enabled = value;
+    if (!enabled) clear();
+}
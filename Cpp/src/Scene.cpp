@@ -2,75 +2,331 @@
 #include <typeinfo>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 
 #include "Block.h"
 #include "Player.h"
 #include "Enemy.h"
 #include "Hittable.h"
 #include "Game.h"
+#include "CollisionBaker.h"
+#include "Kinematics.h"
+#include "ParticleSystem.h"
 
 #include "NetworkClient.h"
 #include "NetMessages.h"
 
-Scene::Scene() : isHost(false) {}
+// Tick di rete di default: 20 Hz (un terzo della simulazione)
+Scene::Scene(NetworkClient& network) : network(network), tilesDirty(false), collisionDirty(false), actorSetVersion(0),
+    netTickInterval(1.f / 20.f), netTickTimer(0.f), netTick(0),
+    compactEpoch(0), ticksSinceKeyframe(0), dt(0.f), renderAlpha(1.f), localPlayerId(-1), isHost(false) {}
 
-std::vector<Block*> Scene::getBlocks() const
+Scene::~Scene() = default;
+
+float Scene::getDt() const
+{
+    return dt;
+}
+
+void Scene::setNetTickRate(float hz)
 {
-    std::vector<Block*> blocks;
-    for (const auto& entity : entities)
+    netTickInterval = hz > 0.f ? 1.f / hz : 0.f;
+}
+
+EntityHandle Scene::addEntity(std::unique_ptr<GameObject> entity)
+{
+    // Slot + generazione: l'handle è valido da subito
+    uint32_t index;
+    if (!freeSlots.empty())
     {
-        if (Block* b = dynamic_cast<Block*>(entity.get()))
-        {
-            blocks.push_back(b);
-        }
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
     }
-    return blocks;
+    EntitySlot& slot = slots[index];
+    slot.entity = entity.get();
+    slot.despawning = false;
+    entity->handle.index = index;
+    entity->handle.generation = slot.generation;
+
+    // Gli indici per ID si aggiornano subito: un pacchetto che arriva nello stesso
+    // frame deve trovare l'entità anche se non è ancora in 'entities'
+    if (Player* p = dynamic_cast<Player*>(entity.get()))
+    {
+        playersById[static_cast<uint32_t>(p->getId())] = p;
+        if (p->isLocal())
+            localPlayerHandle = entity->handle;
+    }
+    else if (Enemy* e = dynamic_cast<Enemy*>(entity.get()))
+    {
+        enemiesById[e->getId()] = e;
+    }
+
+    EntityHandle handle = entity->handle;
+    spawnQueue.push_back(std::move(entity));
+    return handle;
 }
 
-std::vector<Player*> Scene::getPlayers() const
+void Scene::removeEntity(EntityHandle handle)
 {
-    std::vector<Player*> players;
-    for (const auto& entity : entities)
+    if (GameObject* entity = getEntity(handle))
+        despawnEntity(entity);
+}
+
+GameObject* Scene::getEntity(EntityHandle handle) const
+{
+    if (handle.isNull() || handle.index >= slots.size()) return nullptr;
+    const EntitySlot& slot = slots[handle.index];
+    return slot.generation == handle.generation ? slot.entity : nullptr;
+}
+
+// Accoda la rimozione (una sola volta) e toglie subito l'entità dagli indici per ID
+void Scene::despawnEntity(GameObject* entity)
+{
+    EntitySlot& slot = slots[entity->handle.index];
+    if (slot.despawning) return;
+    slot.despawning = true;
+    despawnQueue.push_back(entity);
+
+    if (Player* p = dynamic_cast<Player*>(entity))
+        unindexPlayer(p);
+    else if (Enemy* e = dynamic_cast<Enemy*>(entity))
+        unindexEnemy(e);
+}
+
+bool Scene::isDespawning(const GameObject* entity) const
+{
+    return slots[entity->handle.index].despawning;
+}
+
+void Scene::flushCommands()
+{
+    // Prima gli spawn (così un'entità creata e rimossa nello stesso frame segue il percorso normale)
+    if (!spawnQueue.empty())
     {
-        if (Player* p = dynamic_cast<Player*>(entity.get()))
+        entities.reserve(entities.size() + spawnQueue.size());
+        for (auto& entity : spawnQueue)
         {
-            players.push_back(p);
+            registerEntity(entity.get());
+            entities.push_back(std::move(entity));
         }
+        spawnQueue.clear();
     }
-    return players;
+
+    applyDespawns();
 }
 
-std::vector<Enemy*> Scene::getEnemies() const
+// Classifica l'entità una volta sola, all'inserimento
+void Scene::registerEntity(GameObject* entity)
 {
-    std::vector<Enemy*> enemies;
-    for (const auto& entity : entities)
+    if (Block* b = dynamic_cast<Block*>(entity))
+    {
+        blocks.push_back(b);
+        collisionDirty = true;
+        tilesDirty = true;
+    }
+    else if (Player* p = dynamic_cast<Player*>(entity))
+    {
+        players.push_back(p);
+        actorSetVersion++;
+    }
+    else if (Enemy* e = dynamic_cast<Enemy*>(entity))
     {
-        if (Enemy* e = dynamic_cast<Enemy*>(entity.get()))
+        enemies.push_back(e);
+        actorSetVersion++;
+    }
+    else
+        others.push_back(entity);
+}
+
+// Rimuove in blocco le entità accodate: una sola passata remove_if per vettore,
+// con il test di appartenenza O(1) sul flag dello slot
+void Scene::applyDespawns()
+{
+    if (despawnQueue.empty()) return;
+
+    auto isDoomed = [this](const GameObject* entity) {
+        return slots[entity->handle.index].despawning;
+    };
+
+    std::size_t blockCount = blocks.size();
+    blocks.erase(std::remove_if(blocks.begin(), blocks.end(), isDoomed), blocks.end());
+    if (blocks.size() != blockCount)
+    {
+        collisionDirty = true;
+        tilesDirty = true;
+    }
+    players.erase(std::remove_if(players.begin(), players.end(), isDoomed), players.end());
+    enemies.erase(std::remove_if(enemies.begin(), enemies.end(), isDoomed), enemies.end());
+    actorSetVersion++;
+    others.erase(std::remove_if(others.begin(), others.end(), isDoomed), others.end());
+
+    // Libera gli slot prima di distruggere le entità (servono i loro handle)
+    releasedSlots.clear();
+    for (GameObject* entity : despawnQueue)
+    {
+        releasedSlots.push_back(entity->handle.index);
+    }
+    despawnQueue.clear();
+
+    // I nemici non vengono distrutti: tornano nel pool (l'unique_ptr svuotato viene tolto sotto)
+    for (auto& entity : entities)
+    {
+        if (!isDoomed(entity.get())) continue;
+        if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get()))
         {
-            enemies.push_back(e);
+            enemy->deactivate();
+            entity.release();
+            enemyPool.emplace_back(enemy);
         }
     }
-    return enemies;
+
+    entities.erase(
+        std::remove_if(entities.begin(), entities.end(),
+            [&isDoomed](const std::unique_ptr<GameObject>& entity) {
+                return !entity || isDoomed(entity.get());
+            }),
+        entities.end()
+    );
+
+    for (uint32_t index : releasedSlots)
+    {
+        EntitySlot& slot = slots[index];
+        slot.entity = nullptr;
+        slot.generation++; // invalida tutti gli handle verso questa entità
+        slot.despawning = false;
+        freeSlots.push_back(index);
+    }
 }
 
-float Scene::getDt() const
+// Rimuove l'entry solo se punta proprio a questa entità (ID duplicati non rompono l'indice)
+void Scene::unindexPlayer(Player* player)
 {
-    return dt;
+    auto it = playersById.find(static_cast<uint32_t>(player->getId()));
+    if (it != playersById.end() && it->second == player)
+        playersById.erase(it);
+}
+
+void Scene::unindexEnemy(Enemy* enemy)
+{
+    auto it = enemiesById.find(enemy->getId());
+    if (it != enemiesById.end() && it->second == enemy)
+        enemiesById.erase(it);
+}
+
+Player* Scene::findPlayer(uint32_t playerId) const
+{
+    auto it = playersById.find(playerId);
+    return it != playersById.end() ? it->second : nullptr;
+}
+
+Enemy* Scene::findEnemy(uint32_t enemyId) const
+{
+    auto it = enemiesById.find(enemyId);
+    return it != enemiesById.end() ? it->second : nullptr;
+}
+
+// Cambia l'ID di un player già in scena mantenendo l'indice coerente
+void Scene::changePlayerId(Player* player, uint32_t newId)
+{
+    unindexPlayer(player);
+    player->setId(static_cast<int>(newId));
+    playersById[newId] = player;
 }
 
-void Scene::addEntity(std::unique_ptr<GameObject> entity)
+void Scene::rebuildCollision()
 {
-    entities.push_back(std::move(entity));
+    std::vector<sf::FloatRect> tiles;
+    tiles.reserve(blocks.size());
+    for (Block* block : blocks)
+    {
+        tiles.push_back(block->getBounds());
+    }
+
+    solidRects = bakeCollisionRects(std::move(tiles));
+
+    solidGrid.clear();
+    for (const auto& rect : solidRects)
+    {
+        solidGrid.insert(rect);
+    }
+    collisionDirty = false;
+
+    std::cout << "🧱 Collisioni: " << blocks.size() << " blocchi -> " << solidRects.size() << " rettangoli" << std::endl;
+}
+
+const std::vector<sf::FloatRect>& Scene::querySolids(const sf::FloatRect& area) const
+{
+    solidGrid.query(area, gridQueryIndices);
+
+    solidQueryResult.clear();
+    for (uint32_t index : gridQueryIndices)
+    {
+        solidQueryResult.push_back(solidRects[index]);
+    }
+    return solidQueryResult;
+}
+
+const std::vector<Player*>& Scene::queryPlayers(const sf::FloatRect& area) const
+{
+    playerBroadphase.query(area, playerQueryResult);
+    return playerQueryResult;
+}
+
+const std::vector<Enemy*>& Scene::queryEnemies(const sf::FloatRect& area) const
+{
+    enemyBroadphase.query(area, enemyQueryResult);
+    return enemyQueryResult;
 }
 
 // Implementazione della funzione helper definita in Scene.h
-void Scene::addRemotePlayer(int id)
+Player* Scene::addRemotePlayer(int id, float x, float y)
 {
     // Creiamo il player remoto (false = non controllato da tastiera)
-    auto remotePlayer = std::make_unique<Player>("PM1", "Nemico", false);
+    auto remotePlayer = std::make_unique<Player>(kinematics, animations, network, "PM1", "Nemico", false);
     remotePlayer->setId(id);
+    remotePlayer->setInitialPosition(x, y);
+    Player* player = remotePlayer.get();
     addEntity(std::move(remotePlayer));
     std::cout << "🌐 Connesso nuovo giocatore remoto: ID " << id << std::endl;
+    return player;
+}
+
+Enemy* Scene::spawnEnemy(uint32_t id, bool localControl, float x, float y)
+{
+    std::unique_ptr<Enemy> enemy;
+    if (!enemyPool.empty())
+    {
+        enemy = std::move(enemyPool.back());
+        enemyPool.pop_back();
+        enemy->reset(id, localControl, x, y);
+    }
+    else
+    {
+        enemy = std::make_unique<Enemy>(kinematics, animations, network, "PM2", id, localControl);
+        enemy->setInitialPosition(x, y);
+    }
+
+    Enemy* spawned = enemy.get();
+    addEntity(std::move(enemy));
+    return spawned;
+}
+
+void Scene::prewarmEnemies(std::size_t count)
+{
+    enemyPool.reserve(count);
+    while (enemyPool.size() < count)
+    {
+        auto enemy = std::make_unique<Enemy>(kinematics, animations, network, "PM2");
+        enemy->deactivate();
+        enemyPool.push_back(std::move(enemy));
+    }
+    std::cout << "👾 Pool nemici: " << enemyPool.size() << " istanze pronte" << std::endl;
 }
 
 void Scene::removePlayer(uint32_t playerId)
@@ -83,54 +339,67 @@ void Scene::removePlayer(uint32_t playerId)
     }
     
     // Cerca e rimuovi il player con l'ID specificato
-    auto it = std::remove_if(entities.begin(), entities.end(),
-        [playerId](const std::unique_ptr<GameObject>& entity) {
-            if (Player* player = dynamic_cast<Player*>(entity.get()))
-            {
-                if (player->getId() == playerId)
-                {
-                    std::cout << "👋 Rimosso giocatore disconnesso: ID " << playerId << std::endl;
-                    return true;
-                }
-            }
-            return false;
-        });
-    
-    entities.erase(it, entities.end());
+    if (Player* player = findPlayer(playerId))
+    {
+        std::cout << "👋 Rimosso giocatore disconnesso: ID " << playerId << std::endl;
+        despawnEntity(player);
+    }
+    receivedPlayerStates.erase(playerId);
 }
 
 void Scene::update()
 {
+    // Spawn/despawn richiesti fuori da update() (es. cambio livello)
+    flushCommands();
+
+    // Inizio tick: salva le posizioni correnti per l'interpolazione del render
+    // (prima della rete, così anche i sync dei remoti vengono interpolati)
+    kinematics.beginTick();
+
+    if (collisionDirty)
+    {
+        rebuildCollision();
+    }
+
     // --------------------------------------------------------
     // GESTIONE RETE
     // --------------------------------------------------------
-    PacketHeader header;
-    size_t received;
-
-    // Processiamo TUTTI i pacchetti arrivati (non solo uno alla volta).
-    while (NetworkClient::getInstance()->receive(&header, sizeof(header), received) == sf::Socket::Done)
+    // Un'unica lettura svuota il socket nel buffer di ricezione, poi processiamo
+    // TUTTI i pacchetti completi arrivati leggendoli sul posto.
+    // Un pacchetto a metà resta nel buffer e verrà completato al prossimo tick.
+    network.poll();
+    PacketView packet;
+    while (network.nextPacket(packet))
     {
-        // Controllo validità header
-        if (received != sizeof(header)) break;
+        const uint32_t type = packet.type();
 
+        // I nemici li simula l'host: se siamo noi, lo stato mandato da altri si scarta
+        // (es. un client che ha scelto "Ospita partita" prima di ricevere HOST_ANNOUNCE:
+        // i suoi ID si sovrapporrebbero ai nostri)
+        if (isHost && (type == PacketType::ENEMY_SPAWN || type == PacketType::ENEMY_UPDATE ||
+                       type == PacketType::ENEMY_SNAPSHOT || type == PacketType::ENEMY_SNAPSHOT_COMPACT))
+            continue;
+
+        // Pacchetto PING: è il nostro, rimandato dal server (misura della latenza)
+        if (type == PacketType::PING)
+        {
+            if (const PacketPing* pingPacket = packet.as<PacketPing>())
+                network.onPing(*pingPacket);
+        }
         // Pacchetto LOGIN: il server ci comunica il nostro ID reale
-        if (header.type == PacketType::LOGIN)
+        else if (type == PacketType::LOGIN)
         {
-            uint32_t serverAssignedId;
-            if (NetworkClient::getInstance()->receive(&serverAssignedId, sizeof(serverAssignedId), received) != sf::Socket::Done)
-                break;
+            const PacketLogin* loginPacket = packet.as<PacketLogin>();
+            if (!loginPacket) continue;
+            uint32_t serverAssignedId = loginPacket->playerId;
             
             std::cout << "🆔 Server ci ha assegnato ID: " << serverAssignedId << std::endl;
             
-            // Aggiorna l'ID del player locale
-            for (auto* player : getPlayers())
+            // Aggiorna l'ID del player locale (e il suo indice)
+            if (Player* player = getLocalPlayerInScene())
             {
-                if (player->isLocal())
-                {
-                    player->setId(serverAssignedId);
-                    std::cout << "   Player locale aggiornato con ID " << serverAssignedId << std::endl;
-                    break;
-                }
+                changePlayerId(player, serverAssignedId);
+                std::cout << "   Player locale aggiornato con ID " << serverAssignedId << std::endl;
             }
             
             // Aggiorna anche localPlayerId nella scena
@@ -138,282 +407,316 @@ void Scene::update()
             
             // Aggiorna nel Game
             Game::getInstance()->setLocalPlayerId(serverAssignedId);
-            
-            continue;
         }
-
         // Pacchetto PLAYER_DISCONNECTED: un giocatore si è disconnesso
-        if (header.type == PacketType::PLAYER_DISCONNECTED)
+        else if (type == PacketType::PLAYER_DISCONNECTED)
         {
-            uint32_t disconnectedPlayerId;
-            if (NetworkClient::getInstance()->receive(&disconnectedPlayerId, sizeof(disconnectedPlayerId), received) != sf::Socket::Done)
-                break;
-            
-            std::cout << "📤 Player " << disconnectedPlayerId << " si è disconnesso" << std::endl;
-            removePlayer(disconnectedPlayerId);
+            const PacketPlayerDisconnected* disconnectPacket = packet.as<PacketPlayerDisconnected>();
+            if (!disconnectPacket) continue;
             
-            continue;
+            std::cout << "📤 Player " << disconnectPacket->playerId << " si è disconnesso" << std::endl;
+            removePlayer(disconnectPacket->playerId);
         }
+        // Pacchetto HOST_ANNOUNCE: qualcun altro (es. il server dedicato) controlla i nemici
+        else if (type == PacketType::HOST_ANNOUNCE)
+        {
+            const PacketHostAnnounce* announcePacket = packet.as<PacketHostAnnounce>();
+            if (!announcePacket) continue;
 
-        if (header.type == PacketType::MOVE)
+            // Se eravamo host cediamo la simulazione: i nostri nemici spariscono
+            // e al loro posto arrivano quelli dell'host annunciato (ENEMY_SPAWN/snapshot).
+            // Il contatore riparte da zero e si riempie con gli ENEMY_SPAWN del nuovo host.
+            if (isHost && announcePacket->hostPlayerId != static_cast<uint32_t>(localPlayerId))
+            {
+                std::cout << "Host annunciato: ID " << announcePacket->hostPlayerId << ", smetto di controllare i nemici" << std::endl;
+                Game::getInstance()->setIsHost(false);
+                Game::getInstance()->setEnemiesToDefeat(0);
+                despawnAllEnemies(); // siamo dentro update(): la rimozione va al flushCommands() di fine tick
+            }
+        }
+        else if (type == PacketType::MOVE)
         {
-            PacketMove movePacket;
-            movePacket.header = header;      
-            
-            size_t remainingSize = sizeof(PacketMove) - sizeof(PacketHeader);
-            char* buffer = (char*)&movePacket + sizeof(PacketHeader); 
-            
-            // Riceviamo il corpo del messaggio
-            if (NetworkClient::getInstance()->receive(buffer, remainingSize, received) != sf::Socket::Done)
-                break; // Errore di lettura, usciamo
+            const PacketMove* movePacket = packet.as<PacketMove>();
+            if (!movePacket) continue;
 
             // Se il pacchetto è mio (del local player), lo ignoro.
             // (Il server me lo rimanda indietro, ma io so già dove sono)
-            if (movePacket.playerId == localPlayerId) continue;
+            if (movePacket->playerId == localPlayerId) continue;
 
-            bool found = false;
-            auto players = getPlayers(); 
-
-            // 1. Aggiornamento Player Esistente
-            for (auto* player : players)
-            {
-                if (player->getId() == movePacket.playerId)
-                {
-                    player->syncFromNetwork(
-                        movePacket.x, movePacket.y, 
-                        movePacket.velocityX, movePacket.velocityY, 
-                        movePacket.isFacingRight, movePacket.isGrounded
-                    );
-                    found = true;
-                    break;
-                }
-            }
+            applyPlayerMove(movePacket->playerId,
+                movePacket->x, movePacket->y,
+                movePacket->velocityX, movePacket->velocityY,
+                movePacket->isFacingRight, movePacket->isGrounded);
+        }
+        // MOVE compatto: record quantizzato, completo o delta rispetto all'ultimo ricevuto
+        else if (type == PacketType::MOVE_COMPACT)
+        {
+            const PacketMoveCompact* movePacket = packet.as<PacketMoveCompact>();
+            if (!movePacket) continue;
+            if (movePacket->playerId == static_cast<uint32_t>(localPlayerId)) continue;
 
-            // 2. Creazione Nuovo Player (se non trovato)
-            if (!found)
-            {
-                // Usiamo la funzione helper per pulizia
-                addRemotePlayer(movePacket.playerId);
+            BitReader reader(reinterpret_cast<const uint8_t*>(packet.data) + sizeof(PacketMoveCompact),
+                             packet.size - sizeof(PacketMoveCompact));
+            auto baseline = receivedPlayerStates.find(movePacket->playerId);
+            QuantizedState state;
+            // Delta senza baseline: si aspetta il prossimo keyframe
+            if (!readStateRecord(reader, state, baseline != receivedPlayerStates.end() ? &baseline->second : nullptr, false))
+                continue;
+            if (reader.failed()) continue;
+            receivedPlayerStates[movePacket->playerId] = state;
 
-                // E dobbiamo sincronizzarlo SUBITO per evitare che appaia a (0,0) per un frame
-                // Cerchiamo l'ultimo elemento aggiunto (che è il nostro nuovo player)
-                // Nota: sappiamo che è un Player perché lo abbiamo appena aggiunto.
-                if (Player* newP = dynamic_cast<Player*>(entities.back().get()))
-                {
-                    newP->syncFromNetwork(
-                        movePacket.x, movePacket.y, 
-                        movePacket.velocityX, movePacket.velocityY, 
-                        movePacket.isFacingRight, movePacket.isGrounded
-                    );
-                }
-            }
+            applyPlayerMove(movePacket->playerId,
+                dequantizeX(state.x), dequantizeY(state.y),
+                dequantizeVelocity(state.velocityX), dequantizeVelocity(state.velocityY),
+                (state.flags & STATE_FACING_RIGHT) != 0, (state.flags & STATE_GROUNDED) != 0);
         }
-        else if (header.type == PacketType::ENEMY_SPAWN)
+        // Capacità comuni a tutta la sessione (vedi NetworkClient::useCompactState)
+        else if (type == PacketType::NET_CAPS)
         {
-            PacketEnemySpawn spawnPacket;
-            spawnPacket.header = header;
-            
-            size_t remainingSize = sizeof(PacketEnemySpawn) - sizeof(PacketHeader);
-            char* buffer = (char*)&spawnPacket + sizeof(PacketHeader);
-            
-            if (NetworkClient::getInstance()->receive(buffer, remainingSize, received) != sf::Socket::Done)
-                break;
-            
-            // Controlla se il nemico esiste già
-            bool found = false;
-            for (auto* enemy : getEnemies())
-            {
-                if (enemy->getId() == spawnPacket.enemyId)
-                {
-                    found = true;
-                    break;
-                }
-            }
+            const PacketNetCaps* capsPacket = packet.as<PacketNetCaps>();
+            if (!capsPacket) continue;
+            network.onNetCaps(*capsPacket);
+        }
+        else if (type == PacketType::ENEMY_SPAWN)
+        {
+            const PacketEnemySpawn* spawnPacket = packet.as<PacketEnemySpawn>();
+            if (!spawnPacket) continue;
             
-            // Se non esiste, crealo (nemico controllato dall'host, noi siamo client)
-            if (!found)
+            // Se non esiste già, crealo (nemico controllato dall'host, noi siamo client)
+            if (!findEnemy(spawnPacket->enemyId))
             {
-                auto remoteEnemy = std::make_unique<Enemy>("PM2", spawnPacket.enemyId, false); // false = non controlliamo
-                remoteEnemy->setInitialPosition(spawnPacket.x, spawnPacket.y);
-                addEntity(std::move(remoteEnemy));
+                spawnEnemy(spawnPacket->enemyId, false, spawnPacket->x, spawnPacket->y); // false = non controlliamo
                 
                 // Aggiorna il contatore di nemici da sconfiggere
                 Game::getInstance()->incrementEnemiesToDefeat();
                 
-                std::cout << "👾 Nemico spawnato da host: ID " << spawnPacket.enemyId 
-                          << " a (" << spawnPacket.x << ", " << spawnPacket.y << ")" << std::endl;
+                std::cout << "👾 Nemico spawnato da host: ID " << spawnPacket->enemyId 
+                          << " a (" << spawnPacket->x << ", " << spawnPacket->y << ")" << std::endl;
             }
         }
-        else if (header.type == PacketType::ENEMY_UPDATE)
+        // Vecchio formato, un pacchetto per nemico (host non aggiornati)
+        else if (type == PacketType::ENEMY_UPDATE)
         {
-            PacketEnemyUpdate enemyPacket;
-            enemyPacket.header = header;
-            
-            size_t remainingSize = sizeof(PacketEnemyUpdate) - sizeof(PacketHeader);
-            char* buffer = (char*)&enemyPacket + sizeof(PacketHeader);
-            
-            if (NetworkClient::getInstance()->receive(buffer, remainingSize, received) != sf::Socket::Done)
-                break;
-            
-            // Trova il nemico e aggiornalo
-            bool found = false;
-            for (auto* enemy : getEnemies())
+            const PacketEnemyUpdate* enemyPacket = packet.as<PacketEnemyUpdate>();
+            if (!enemyPacket) continue;
+
+            EnemyNetState state;
+            state.enemyId = enemyPacket->enemyId;
+            state.x = enemyPacket->x;
+            state.y = enemyPacket->y;
+            state.velocityX = enemyPacket->velocityX;
+            state.velocityY = enemyPacket->velocityY;
+            state.isFacingRight = enemyPacket->isFacingRight;
+            state.isGrounded = enemyPacket->isGrounded;
+            state.isAttacking = enemyPacket->isAttacking;
+            state.currentHealth = enemyPacket->currentHealth;
+            applyEnemyState(state);
+        }
+        // Snapshot: lo stato di tutti i nemici dell'host in un solo pacchetto
+        else if (type == PacketType::ENEMY_SNAPSHOT)
+        {
+            const PacketEnemySnapshot* snapshot = packet.as<PacketEnemySnapshot>();
+            if (!snapshot) continue;
+            if (packet.size < sizeof(PacketEnemySnapshot) + snapshot->count * sizeof(EnemyNetState)) continue;
+
+            // Stati subito dopo l'intestazione (pack(1): si leggono sul posto)
+            const EnemyNetState* states = reinterpret_cast<const EnemyNetState*>(packet.data + sizeof(PacketEnemySnapshot));
+            for (uint16_t i = 0; i < snapshot->count; i++)
             {
-                if (enemy->getId() == enemyPacket.enemyId)
-                {
-                    enemy->syncFromNetwork(
-                        enemyPacket.x, enemyPacket.y,
-                        enemyPacket.velocityX, enemyPacket.velocityY,
-                        enemyPacket.isFacingRight, enemyPacket.isGrounded,
-                        enemyPacket.isAttacking, enemyPacket.currentHealth
-                    );
-                    found = true;
-                    break;
-                }
+                applyEnemyState(states[i]);
             }
-            
-            // Se non esiste, crealo (nemico remoto)
-            if (!found)
+        }
+        // Snapshot compatto: [id, record] impacchettati a bit, solo i nemici cambiati
+        else if (type == PacketType::ENEMY_SNAPSHOT_COMPACT)
+        {
+            const PacketEnemySnapshotCompact* snapshot = packet.as<PacketEnemySnapshotCompact>();
+            if (!snapshot) continue;
+
+            BitReader reader(reinterpret_cast<const uint8_t*>(packet.data) + sizeof(PacketEnemySnapshotCompact),
+                             packet.size - sizeof(PacketEnemySnapshotCompact));
+            for (uint16_t i = 0; i < snapshot->count; i++)
             {
-                auto remoteEnemy = std::make_unique<Enemy>("PM2", enemyPacket.enemyId, false);
-                remoteEnemy->syncFromNetwork(
-                    enemyPacket.x, enemyPacket.y,
-                    enemyPacket.velocityX, enemyPacket.velocityY,
-                    enemyPacket.isFacingRight, enemyPacket.isGrounded,
-                    enemyPacket.isAttacking, enemyPacket.currentHealth
-                );
-                addEntity(std::move(remoteEnemy));
-                std::cout << "👾 Nemico remoto creato: ID " << enemyPacket.enemyId << std::endl;
+                uint32_t enemyId = readEntityId(reader);
+                auto baseline = receivedEnemyStates.find(enemyId);
+                QuantizedState state;
+                bool complete = readStateRecord(reader, state, baseline != receivedEnemyStates.end() ? &baseline->second : nullptr, true);
+                if (reader.failed()) break; // pacchetto troncato: il resto non è affidabile
+                if (!complete) continue;
+
+                receivedEnemyStates[enemyId] = state;
+                applyEnemyState(dequantizeEnemyState(enemyId, state));
             }
         }
-        else if (header.type == PacketType::ENEMY_DAMAGE)
+        else if (type == PacketType::ENEMY_DAMAGE)
         {
-            PacketEnemyDamage damagePacket;
-            damagePacket.header = header;
-            
-            size_t remainingSize = sizeof(PacketEnemyDamage) - sizeof(PacketHeader);
-            char* buffer = (char*)&damagePacket + sizeof(PacketHeader);
-            
-            if (NetworkClient::getInstance()->receive(buffer, remainingSize, received) != sf::Socket::Done)
-                break;
+            const PacketEnemyDamage* damagePacket = packet.as<PacketEnemyDamage>();
+            if (!damagePacket) continue;
             
             // Applica il danno al nemico
-            for (auto* enemy : getEnemies())
+            if (Enemy* enemy = findEnemy(damagePacket->enemyId))
             {
-                if (enemy->getId() == damagePacket.enemyId)
-                {
-                    enemy->takeDamage(damagePacket.damage);
-                    std::cout << "👾 Nemico " << damagePacket.enemyId << " ha subito " << damagePacket.damage << " danni!" << std::endl;
-                    break;
-                }
+                enemy->takeDamage(damagePacket->damage);
+                std::cout << "👾 Nemico " << damagePacket->enemyId << " ha subito " << damagePacket->damage << " danni!" << std::endl;
             }
         }
-        else if (header.type == PacketType::PLAYER_ATTACK)
+        else if (type == PacketType::PLAYER_ATTACK)
         {
-            PacketPlayerAttack attackPacket;
-            attackPacket.header = header;
-            
-            size_t remainingSize = sizeof(PacketPlayerAttack) - sizeof(PacketHeader);
-            char* buffer = (char*)&attackPacket + sizeof(PacketHeader);
-            
-            if (NetworkClient::getInstance()->receive(buffer, remainingSize, received) != sf::Socket::Done)
-                break;
+            const PacketPlayerAttack* attackPacket = packet.as<PacketPlayerAttack>();
+            if (!attackPacket) continue;
             
             // Ignora pacchetti del nostro player
-            if (attackPacket.playerId == localPlayerId)
+            if (attackPacket->playerId == localPlayerId)
                 continue;
             
             // Trova il player e attiva l'animazione di attacco
-            for (auto* player : getPlayers())
+            if (Player* player = findPlayer(attackPacket->playerId))
             {
-                if (player->getId() == attackPacket.playerId)
-                {
-                    player->triggerAttackAnimation();
-                    break;
-                }
+                player->triggerAttackAnimation();
             }
         }
-        else if (header.type == PacketType::PLAYER_DAMAGE)
+        else if (type == PacketType::PLAYER_DAMAGE)
         {
-            PacketPlayerDamage damagePacket;
-            damagePacket.header = header;
-            
-            size_t remainingSize = sizeof(PacketPlayerDamage) - sizeof(PacketHeader);
-            char* buffer = (char*)&damagePacket + sizeof(PacketHeader);
-            
-            if (NetworkClient::getInstance()->receive(buffer, remainingSize, received) != sf::Socket::Done)
-                break;
+            const PacketPlayerDamage* damagePacket = packet.as<PacketPlayerDamage>();
+            if (!damagePacket) continue;
             
             // Trova il player e applica il danno
-            for (auto* player : getPlayers())
+            if (Player* player = findPlayer(damagePacket->playerId))
             {
-                if (player->getId() == damagePacket.playerId)
+                if (player->isLocal())
                 {
-                    if (player->isLocal())
+                    // Se siamo l'host, ignoriamo - l'host ha già applicato il danno al momento dell'invio
+                    if (!isHost)
                     {
-                        // Se siamo l'host, ignoriamo - l'host ha già applicato il danno al momento dell'invio
-                        if (!isHost)
-                        {
-                            player->applyDamageFromHost(damagePacket.damage);
-                        }
+                        player->applyDamageFromHost(damagePacket->damage);
                     }
-                    else
-                    {
-                        // Aggiorna il player remoto (questo è il caso dell'host che riceve info sul client)
-                        player->syncDamageFromNetwork(damagePacket.damage, damagePacket.currentHealth);
-                    }
-                    break;
+                }
+                else
+                {
+                    // Aggiorna il player remoto (questo è il caso dell'host che riceve info sul client)
+                    player->syncDamageFromNetwork(damagePacket->damage, damagePacket->currentHealth);
                 }
             }
         }
+        // Tipi sconosciuti (o non gestiti qui): il frame è già stato saltato per intero
     }
 
     // --------------------------------------------------------
     // AGGIORNAMENTO GIOCO
     // --------------------------------------------------------
+    // Broadphase attori: una volta per tick, prima che AI e attacchi la interroghino
+    playerBroadphase.update(players, actorSetVersion);
+    enemyBroadphase.update(enemies, actorSetVersion);
+
     for(auto& entity : entities)
     {
         entity->update(*this);
     }
+
+    // Fisica: un solo passo su tutti i body, poi ogni entità legge il risultato
+    kinematics.step(dt, *this);
+
+    for(auto& entity : entities)
+    {
+        entity->lateUpdate(*this);
+    }
+
+    // Tick di rete: lo stato dei nemici che controlliamo parte tutto insieme
+    netTickTimer += dt;
+    if (netTickTimer >= netTickInterval)
+    {
+        netTickTimer = netTickInterval > 0.f ? std::fmod(netTickTimer, netTickInterval) : 0.f;
+        sendEnemySnapshots();
+    }
+
+    // Le entità hanno scelto le clip: tutte le animazioni avanzano insieme
+    animations.update(dt);
+
+    // Effetti (scintille, sbuffi, lava/portali) avanzano col passo fisso
+    ParticleSystem::getInstance()->update(dt);
     
     // Rimuovi entità morte (dopo il loop per evitare crash)
     // E notifica il Game per ogni nemico sconfitto
-    entities.erase(
-        std::remove_if(entities.begin(), entities.end(),
-            [](const std::unique_ptr<GameObject>& entity) {
-                if (Hittable* hittable = dynamic_cast<Hittable*>(entity.get()))
-                {
-                    if (hittable->isDead())
-                    {
-                        // Se è un nemico, decrementa il contatore
-                        if (dynamic_cast<Enemy*>(entity.get()))
-                        {
-                            Game::getInstance()->enemyDefeated();
-                        }
-                        // Se è il player locale, game over
-                        if (Player* player = dynamic_cast<Player*>(entity.get()))
-                        {
-                            if (player->isLocal())
-                            {
-                                Game::getInstance()->setGameOver();
-                                return false; // Non rimuovere il player
-                            }
-                        }
-                        return true;
-                    }
-                }
-                return false;
-            }),
-        entities.end()
-    );
+    for (Enemy* enemy : enemies)
+    {
+        if (enemy->isDead() && !isDespawning(enemy))
+        {
+            Game::getInstance()->enemyDefeated();
+            despawnEntity(enemy);
+        }
+    }
+    for (Player* player : players)
+    {
+        if (player->isDead())
+        {
+            // Se è il player locale, game over (ma non lo rimuoviamo)
+            if (player->isLocal())
+            {
+                Game::getInstance()->setGameOver();
+                continue;
+            }
+            despawnEntity(player);
+        }
+    }
+    for (GameObject* other : others)
+    {
+        if (Hittable* hittable = dynamic_cast<Hittable*>(other))
+        {
+            if (hittable->isDead())
+                despawnEntity(other);
+        }
+    }
+
+    // Applica in blocco gli spawn/despawn di questo frame (rete + morti)
+    flushCommands();
 }
 
-void Scene::draw(sf::RenderWindow& window) const
+void Scene::captureSnapshot(RenderSnapshot& out, float alpha)
 {
-    for (auto& entity : entities)
+    // Mappa: una nuova lista solo quando i blocchi cambiano, altrimenti si condivide la stessa
+    if (tilesDirty)
+    {
+        auto tiles = std::make_shared<std::vector<StaticTile>>();
+        tiles->reserve(blocks.size());
+        for (const Block* block : blocks)
+        {
+            tiles->push_back(StaticTile{ block->getTexture(), block->getBounds(), block->getTextureRect() });
+        }
+        staticTiles = std::move(tiles);
+        tilesDirty = false;
+    }
+    out.tiles = staticTiles;
+
+    // Tutti gli attori (sono poche decine): il culling lo fa il renderer con la sua telecamera.
+    // I player dopo i nemici, così vengono disegnati in primo piano.
+    out.actors.clear();
+    out.cameraTarget = -1;
+    for (Enemy* enemy : enemies)
     {
-        entity->draw(window);
+        out.actors.emplace_back();
+        enemy->captureRender(out.actors.back());
     }
+    GameObject* localPlayer = getEntity(localPlayerHandle);
+    for (Player* player : players)
+    {
+        if (player == localPlayer)
+            out.cameraTarget = static_cast<int>(out.actors.size());
+        out.actors.emplace_back();
+        player->captureRender(out.actors.back());
+    }
+
+    out.effects.clear();
+    ParticleSystem::getInstance()->capture(out.effects);
+
+    out.hud = Game::getInstance()->getHudState();
+    out.alpha = alpha;
+    out.tickDuration = dt > 0.f ? dt : 1.f / 60.f;
+    out.capturedAt = RenderSnapshot::Clock::now();
+}
+
+void Scene::draw(sf::RenderWindow& window)
+{
+    captureSnapshot(frameSnapshot, renderAlpha);
+    renderer.draw(window, frameSnapshot, renderAlpha);
 }
 
 void Scene::setDt(float dt)
@@ -421,28 +724,174 @@ void Scene::setDt(float dt)
     this->dt = dt;
 }
 
+// Trova il nemico e aggiornalo; se non esiste, crealo (nemico remoto)
+void Scene::applyEnemyState(const EnemyNetState& state)
+{
+    Enemy* enemy = findEnemy(state.enemyId);
+    if (!enemy)
+    {
+        enemy = spawnEnemy(state.enemyId, false, state.x, state.y);
+        std::cout << "👾 Nemico remoto creato: ID " << state.enemyId << std::endl;
+    }
+
+    enemy->syncFromNetwork(
+        state.x, state.y,
+        state.velocityX, state.velocityY,
+        state.isFacingRight, state.isGrounded,
+        state.isAttacking, state.currentHealth
+    );
+}
+
+void Scene::applyPlayerMove(uint32_t playerId, float x, float y, float velocityX, float velocityY,
+                            bool facingRight, bool grounded)
+{
+    // 1. Aggiornamento Player Esistente
+    Player* player = findPlayer(playerId);
+    // 2. Creazione Nuovo Player (se non trovato)
+    if (!player)
+    {
+        // Usiamo la funzione helper per pulizia
+        player = addRemotePlayer(playerId, x, y);
+    }
+
+    // Sincronizziamo SUBITO anche i nuovi (velocità, verso, ...); la posizione iniziale
+    // l'ha già fissata addRemotePlayer, così non appaiono a (100,100) per un frame
+    player->syncFromNetwork(x, y, velocityX, velocityY, facingRight, grounded);
+}
+
+// Un pacchetto ENEMY_SNAPSHOT con tutti i nemici vivi che controlliamo
+// (più pacchetti con lo stesso tick se non stanno nel limite di 1024 byte)
+void Scene::sendEnemySnapshots()
+{
+    if (!network.isConnected()) return;
+    netTick++;
+
+    if (network.useCompactState())
+    {
+        sendCompactEnemySnapshots();
+        return;
+    }
+
+    snapshotBuffer.resize(sizeof(PacketEnemySnapshot));
+    uint16_t count = 0;
+
+    auto sendChunk = [&]() {
+        PacketEnemySnapshot header;
+        header.header.type = PacketType::ENEMY_SNAPSHOT;
+        header.header.packetSize = static_cast<uint32_t>(snapshotBuffer.size());
+        header.tick = netTick;
+        header.count = count;
+        header.padding = 0;
+        std::memcpy(snapshotBuffer.data(), &header, sizeof(header));
+        network.sendBytes(snapshotBuffer.data(), snapshotBuffer.size());
+
+        snapshotBuffer.resize(sizeof(PacketEnemySnapshot));
+        count = 0;
+    };
+
+    for (Enemy* enemy : enemies)
+    {
+        if (!enemy->isLocalControl() || enemy->isDying() || enemy->isDead()) continue;
+
+        EnemyNetState state;
+        enemy->captureNetState(state);
+        const char* bytes = reinterpret_cast<const char*>(&state);
+        snapshotBuffer.insert(snapshotBuffer.end(), bytes, bytes + sizeof(state));
+
+        if (++count == MaxEnemiesPerSnapshot)
+            sendChunk();
+    }
+    if (count > 0)
+        sendChunk();
+}
+
+// Come sendEnemySnapshots(), ma in formato ENEMY_SNAPSHOT_COMPACT: ogni nemico è un delta
+// rispetto all'ultimo stato spedito, e quelli fermi non vengono spediti affatto
+void Scene::sendCompactEnemySnapshots()
+{
+    // Nuova sessione di capacità o keyframe periodico: tutti i nemici ripartono completi
+    if (compactEpoch != network.getCapabilitiesEpoch() || ++ticksSinceKeyframe >= SnapshotKeyframeInterval)
+    {
+        sentEnemyStates.clear();
+        compactEpoch = network.getCapabilitiesEpoch();
+        ticksSinceKeyframe = 0;
+    }
+
+    compactBuffer.assign(sizeof(PacketEnemySnapshotCompact), 0);
+    BitWriter writer(compactBuffer);
+    uint16_t count = 0;
+
+    auto sendChunk = [&]() {
+        PacketEnemySnapshotCompact header;
+        header.header.type = PacketType::ENEMY_SNAPSHOT_COMPACT;
+        header.header.packetSize = static_cast<uint32_t>(compactBuffer.size());
+        header.tick = netTick;
+        header.count = count;
+        header.padding = 0;
+        std::memcpy(compactBuffer.data(), &header, sizeof(header));
+        network.sendBytes(compactBuffer.data(), compactBuffer.size());
+
+        compactBuffer.assign(sizeof(PacketEnemySnapshotCompact), 0);
+        writer.restart();
+        count = 0;
+    };
+
+    for (Enemy* enemy : enemies)
+    {
+        if (!enemy->isLocalControl() || enemy->isDying() || enemy->isDead()) continue;
+
+        EnemyNetState netState;
+        enemy->captureNetState(netState);
+        QuantizedState state = quantizeEnemyState(netState);
+
+        auto baseline = sentEnemyStates.find(netState.enemyId);
+        bool known = baseline != sentEnemyStates.end();
+        if (known && sameState(state, baseline->second, true)) continue;
+
+        // Un record non si spezza fra due pacchetti: se potrebbe non starci, chiudi prima questo
+        if (compactBuffer.size() + MaxStateRecordBytes > NetworkClient::MaxPacketSize)
+            sendChunk();
+
+        writeEntityId(writer, netState.enemyId);
+        writeStateRecord(writer, state, known ? &baseline->second : nullptr, true);
+        sentEnemyStates[netState.enemyId] = state;
+        count++;
+    }
+    if (count > 0)
+        sendChunk();
+}
+
 Player* Scene::getLocalPlayerInScene()
 {
-    auto playersInScene = getPlayers();
-    for(auto& player : playersInScene)
+    return static_cast<Player*>(getEntity(localPlayerHandle));
+}
+
+// Accoda la rimozione di tutti i nemici, compresi quelli spawnati in questo frame e non
+// ancora in 'enemies'. Gli indici per ID si liberano subito; la distruzione (e il ritorno
+// al pool) avviene al prossimo flushCommands().
+void Scene::despawnAllEnemies()
+{
+    for (Enemy* enemy : enemies)
     {
-        if(player->isLocal())
-        {
-            return player;
-        }
+        despawnEntity(enemy);
+    }
+    for (auto& entity : spawnQueue)
+    {
+        if (Enemy* enemy = dynamic_cast<Enemy*>(entity.get()))
+            despawnEntity(enemy);
     }
-    return nullptr;
+
+    // Gli ID dei nemici si riusano: il prossimo stato di ognuno parte completo
+    sentEnemyStates.clear();
+    receivedEnemyStates.clear();
 }
 
+// Chiamata fra un frame e l'altro (cambio livello, restart): applica subito la rimozione,
+// così i nemici tornano nel pool prima che il livello successivo ne richieda di nuovi
 void Scene::removeAllEnemies()
 {
-    entities.erase(
-        std::remove_if(entities.begin(), entities.end(),
-            [](const std::unique_ptr<GameObject>& entity) {
-                return dynamic_cast<Enemy*>(entity.get()) != nullptr;
-            }),
-        entities.end()
-    );
+    despawnAllEnemies();
+    flushCommands();
 }
 
 void Scene::respawnLocalPlayer()
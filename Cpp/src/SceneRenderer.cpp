@@ -0,0 +1,87 @@
+#include "SceneRenderer.h"
+#include "RenderSnapshot.h"
+
+void SceneRenderer::draw(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha)
+{
+    // Mappa: si ricostruisce solo quando la simulazione pubblica un nuovo insieme di blocchi
+    if (snapshot.tiles != currentTiles)
+    {
+        currentTiles = snapshot.tiles;
+        tileLayer.rebuild(currentTiles ? *currentTiles : std::vector<StaticTile>());
+        if (currentTiles && !currentTiles->empty())
+            camera.setWorldBounds(tileLayer.getBounds());
+    }
+    tileLayer.updateCache();
+
+    // Posizioni interpolate fra gli ultimi due tick di simulazione
+    renderPositions.clear();
+    for (const ActorSnapshot& actor : snapshot.actors)
+    {
+        renderPositions.push_back(sf::Vector2f(
+            actor.previousPosition.x + (actor.position.x - actor.previousPosition.x) * alpha,
+            actor.previousPosition.y + (actor.position.y - actor.previousPosition.y) * alpha));
+    }
+
+    // Telecamera sul player locale (alla posizione interpolata, come verrà disegnato)
+    sf::Vector2f viewportSize(static_cast<float>(target.getSize().x), static_cast<float>(target.getSize().y));
+    sf::Vector2f focus(viewportSize.x / 2.f, viewportSize.y / 2.f);
+    if (snapshot.cameraTarget >= 0)
+    {
+        focus = renderPositions[snapshot.cameraTarget];
+    }
+    camera.follow(focus, viewportSize);
+    target.setView(camera.getView());
+
+    sf::FloatRect visibleArea = camera.getVisibleArea();
+    tileLayer.draw(target, visibleArea);
+
+    // Attori visibili. L'area è allargata per health bar e hitbox d'attacco
+    const float cullMargin = 48.f;
+    sf::FloatRect actorArea(visibleArea.left - cullMargin, visibleArea.top - cullMargin,
+                            visibleArea.width + cullMargin * 2.f, visibleArea.height + cullMargin * 2.f);
+    visibleActors.clear();
+    for (std::size_t i = 0; i < snapshot.actors.size(); i++)
+    {
+        if (snapshot.actors[i].texture && actorArea.contains(renderPositions[i]))
+            visibleActors.push_back(i);
+    }
+
+    // Tutti gli sprite in batch, nell'ordine dello snapshot (i player dopo i nemici)
+    batch.clear();
+    for (std::size_t i : visibleActors)
+    {
+        const ActorSnapshot& actor = snapshot.actors[i];
+        scratchSprite.setTexture(*actor.texture);
+        scratchSprite.setTextureRect(actor.textureRect);
+        scratchSprite.setOrigin(actor.origin);
+        scratchSprite.setPosition(renderPositions[i]);
+        scratchSprite.setScale(actor.scaleX, 1.f);
+        scratchSprite.setRotation(actor.rotation);
+        scratchSprite.setColor(actor.color);
+        batch.add(scratchSprite);
+    }
+    batch.draw(target);
+
+    // Effetti sopra gli sprite, sotto health bar e hitbox
+    batch.clear();
+    for (const EffectQuad& effect : snapshot.effects)
+    {
+        if (effect.bounds.intersects(actorArea))
+            batch.add(effect.texture, effect.bounds, effect.rect, effect.color);
+    }
+    batch.draw(target);
+
+    overlay.clear();
+    for (std::size_t i : visibleActors)
+    {
+        const ActorSnapshot& actor = snapshot.actors[i];
+        if (actor.showHealthBar)
+            overlay.addHealthBar(renderPositions[i], actor.healthPercent);
+        if (actor.showHitbox)
+            overlay.addRect(actor.hitbox, sf::Color(255, 0, 0, 100), sf::Color::Red, 2.f);
+    }
+    overlay.draw(target);
+
+    // L'interfaccia (Game::drawHud) si disegna in coordinate finestra
+    target.setView(target.getDefaultView());
+}
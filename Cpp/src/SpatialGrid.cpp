@@ -0,0 +1,80 @@
+#include "SpatialGrid.h"
+#include <cmath>
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(float cellSize) : cellSize(cellSize), queryStamp(0) {}
+
+int64_t SpatialGrid::cellKey(int cx, int cy)
+{
+    return (static_cast<int64_t>(cx) << 32) | static_cast<uint32_t>(cy);
+}
+
+int SpatialGrid::toCell(float coord) const
+{
+    return static_cast<int>(std::floor(coord / cellSize));
+}
+
+void SpatialGrid::clear()
+{
+    cells.clear();
+    bounds.clear();
+    lastSeen.clear();
+    queryStamp = 0;
+}
+
+uint32_t SpatialGrid::insert(const sf::FloatRect& itemBounds)
+{
+    uint32_t index = static_cast<uint32_t>(bounds.size());
+    bounds.push_back(itemBounds);
+    lastSeen.push_back(0);
+
+    int minX = toCell(itemBounds.left);
+    int maxX = toCell(itemBounds.left + itemBounds.width);
+    int minY = toCell(itemBounds.top);
+    int maxY = toCell(itemBounds.top + itemBounds.height);
+
+    for (int cy = minY; cy <= maxY; cy++)
+    {
+        for (int cx = minX; cx <= maxX; cx++)
+        {
+            cells[cellKey(cx, cy)].push_back(index);
+        }
+    }
+    return index;
+}
+
+void SpatialGrid::query(const sf::FloatRect& area, std::vector<uint32_t>& out) const
+{
+    out.clear();
+    if (bounds.empty()) return;
+
+    // Nuovo "timbro" per questa query; al wrap-around azzeriamo i timbri vecchi
+    if (++queryStamp == 0)
+    {
+        std::fill(lastSeen.begin(), lastSeen.end(), 0);
+        queryStamp = 1;
+    }
+
+    int minX = toCell(area.left);
+    int maxX = toCell(area.left + area.width);
+    int minY = toCell(area.top);
+    int maxY = toCell(area.top + area.height);
+
+    for (int cy = minY; cy <= maxY; cy++)
+    {
+        for (int cx = minX; cx <= maxX; cx++)
+        {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) continue;
+
+            for (uint32_t index : it->second)
+            {
+                if (lastSeen[index] == queryStamp) continue;
+                lastSeen[index] = queryStamp;
+
+                if (bounds[index].intersects(area))
+                    out.push_back(index);
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include "SpriteBatch.h"
+#include <cstdlib>
+
+void SpriteBatch::clear()
+{
+    for (std::size_t i = 0; i < activeBatches; i++)
+    {
+        batches[i].vertices.clear();
+    }
+    activeBatches = 0;
+}
+
+sf::VertexArray& SpriteBatch::verticesFor(const sf::Texture* texture)
+{
+    // Cerca il batch della texture fra quelli attivi (sono pochissimi)
+    for (std::size_t i = 0; i < activeBatches; i++)
+    {
+        if (batches[i].texture == texture)
+            return batches[i].vertices;
+    }
+    if (activeBatches == batches.size())
+        batches.push_back(Batch{ texture, sf::VertexArray(sf::Quads) });
+    Batch& batch = batches[activeBatches++];
+    batch.texture = texture;
+    return batch.vertices;
+}
+
+void SpriteBatch::add(const sf::Sprite& sprite)
+{
+    sf::VertexArray& vertices = verticesFor(sprite.getTexture());
+
+    // Stessi vertici che costruisce sf::Sprite, trasformati qui in coordinate mondo
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const sf::Transform& transform = sprite.getTransform();
+    const sf::Color& color = sprite.getColor();
+
+    float width = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+    float left = static_cast<float>(rect.left);
+    float right = left + rect.width;
+    float top = static_cast<float>(rect.top);
+    float bottom = top + rect.height;
+
+    vertices.append(sf::Vertex(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(left, top)));
+    vertices.append(sf::Vertex(transform.transformPoint(width, 0.f), color, sf::Vector2f(right, top)));
+    vertices.append(sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom)));
+    vertices.append(sf::Vertex(transform.transformPoint(0.f, height), color, sf::Vector2f(left, bottom)));
+}
+
+void SpriteBatch::add(const sf::Texture* texture, const sf::FloatRect& bounds, const sf::IntRect& rect, const sf::Color& color)
+{
+    sf::VertexArray& vertices = verticesFor(texture);
+
+    float left = static_cast<float>(rect.left);
+    float right = left + rect.width;
+    float top = static_cast<float>(rect.top);
+    float bottom = top + rect.height;
+
+    vertices.append(sf::Vertex(sf::Vector2f(bounds.left, bounds.top), color, sf::Vector2f(left, top)));
+    vertices.append(sf::Vertex(sf::Vector2f(bounds.left + bounds.width, bounds.top), color, sf::Vector2f(right, top)));
+    vertices.append(sf::Vertex(sf::Vector2f(bounds.left + bounds.width, bounds.top + bounds.height), color, sf::Vector2f(right, bottom)));
+    vertices.append(sf::Vertex(sf::Vector2f(bounds.left, bounds.top + bounds.height), color, sf::Vector2f(left, bottom)));
+}
+
+void SpriteBatch::draw(sf::RenderTarget& target) const
+{
+    for (std::size_t i = 0; i < activeBatches; i++)
+    {
+        sf::RenderStates states;
+        states.texture = batches[i].texture;
+        target.draw(batches[i].vertices, states);
+    }
+}
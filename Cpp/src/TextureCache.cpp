@@ -0,0 +1,83 @@
+#include "TextureCache.h"
+#include <iostream>
+
+// Inizializzazione membro statico
+TextureCache* TextureCache::instance = nullptr;
+
+TextureCache* TextureCache::getInstance()
+{
+    if (instance == nullptr)
+    {
+        instance = new TextureCache();
+    }
+    return instance;
+}
+
+void TextureCache::destroyInstance()
+{
+    delete instance;
+    instance = nullptr;
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::load(const std::string& path)
+{
+    auto it = textures.find(path);
+    if (it != textures.end())
+    {
+        if (auto texture = it->second.lock())
+            return texture;
+    }
+
+    auto texture = std::make_shared<sf::Texture>();
+    if (!headless && !texture->loadFromFile(path))
+    {
+        std::cerr << "Could not load texture from path " << path << std::endl;
+    }
+
+    // Anche una texture fallita resta in cache: non ritentiamo la lettura per ogni entità
+    textures[path] = texture;
+    return texture;
+}
+
+sf::Vector2u TextureCache::getImageSize(const std::string& path)
+{
+    auto it = imageSizes.find(path);
+    if (it != imageSizes.end())
+        return it->second;
+
+    // Texture già in memoria: la dimensione è gratis. Altrimenti si decodifica solo
+    // l'immagine, senza caricare sulla GPU una texture che verrebbe subito liberata
+    auto loaded = textures.find(path);
+    if (loaded != textures.end())
+    {
+        if (auto texture = loaded->second.lock())
+        {
+            if (texture->getSize().x > 0)
+            {
+                imageSizes[path] = texture->getSize();
+                return texture->getSize();
+            }
+        }
+    }
+
+    sf::Image image;
+    if (!image.loadFromFile(path))
+    {
+        std::cerr << "Could not load image from path " << path << std::endl;
+    }
+    // Anche un fallimento resta in cache (dimensione 0x0): non rileggiamo il file ogni volta
+    sf::Vector2u size = image.getSize();
+    imageSizes[path] = size;
+    return size;
+}
+
+std::size_t TextureCache::getLoadedCount() const
+{
+    std::size_t count = 0;
+    for (const auto& entry : textures)
+    {
+        if (!entry.second.expired())
+            count++;
+    }
+    return count;
+}
@@ -0,0 +1,140 @@
+#include "TileLayer.h"
+#include "SpatialGrid.h"
+#include <cmath>
+#include <iostream>
+
+TileLayer::Chunk& TileLayer::chunkFor(int cx, int cy)
+{
+    // I chunk sono pochi (uno ogni 512x512 px): una ricerca lineare al rebuild basta
+    for (auto& chunk : chunks)
+    {
+        if (chunk.cx == cx && chunk.cy == cy)
+            return chunk;
+    }
+    chunks.emplace_back();
+    chunks.back().cx = cx;
+    chunks.back().cy = cy;
+    return chunks.back();
+}
+
+TileLayer::Batch& TileLayer::batchFor(Chunk& chunk, const sf::Texture* texture)
+{
+    // Le texture della mappa sono pochissime: una ricerca lineare basta
+    for (auto& batch : chunk.batches)
+    {
+        if (batch.texture == texture)
+            return batch;
+    }
+    chunk.batches.push_back(Batch{ texture, sf::VertexArray(sf::Quads) });
+    return chunk.batches.back();
+}
+
+void TileLayer::rebuild(const std::vector<StaticTile>& tiles)
+{
+    chunks.clear();
+    bounds = sf::FloatRect();
+    cacheDirty = cacheEnabled;
+
+    bool first = true;
+    for (const StaticTile& staticTile : tiles)
+    {
+        sf::FloatRect tile = staticTile.bounds;
+        sf::IntRect rect = staticTile.textureRect;
+
+        // Il blocco appartiene al chunk che contiene il suo angolo in alto a sinistra
+        Chunk& chunk = chunkFor(static_cast<int>(std::floor(tile.left / ChunkSize)),
+                                static_cast<int>(std::floor(tile.top / ChunkSize)));
+        chunk.bounds = chunk.batches.empty() ? tile : unionRect(chunk.bounds, tile);
+        bounds = first ? tile : unionRect(bounds, tile);
+        first = false;
+
+        sf::VertexArray& vertices = batchFor(chunk, staticTile.texture).vertices;
+
+        float left = static_cast<float>(rect.left);
+        float top = static_cast<float>(rect.top);
+        float right = static_cast<float>(rect.left + rect.width);
+        float bottom = static_cast<float>(rect.top + rect.height);
+
+        // Un quad per blocco, in senso orario a partire dall'angolo in alto a sinistra
+        vertices.append(sf::Vertex(sf::Vector2f(tile.left, tile.top), sf::Vector2f(left, top)));
+        vertices.append(sf::Vertex(sf::Vector2f(tile.left + tile.width, tile.top), sf::Vector2f(right, top)));
+        vertices.append(sf::Vertex(sf::Vector2f(tile.left + tile.width, tile.top + tile.height), sf::Vector2f(right, bottom)));
+        vertices.append(sf::Vertex(sf::Vector2f(tile.left, tile.top + tile.height), sf::Vector2f(left, bottom)));
+    }
+}
+
+void TileLayer::setCacheEnabled(bool enabled)
+{
+    cacheEnabled = enabled;
+    cacheDirty = enabled;
+    if (!enabled)
+    {
+        for (auto& chunk : chunks)
+        {
+            chunk.cache.reset();
+        }
+    }
+}
+
+void TileLayer::updateCache()
+{
+    if (!cacheDirty) return;
+    for (auto& chunk : chunks)
+    {
+        renderCache(chunk);
+    }
+    cacheDirty = false;
+}
+
+// Disegna i vertex array del chunk in una RenderTexture grande quanto il suo AABB
+void TileLayer::renderCache(Chunk& chunk)
+{
+    unsigned width = static_cast<unsigned>(std::ceil(chunk.bounds.width));
+    unsigned height = static_cast<unsigned>(std::ceil(chunk.bounds.height));
+
+    chunk.cache = std::make_unique<sf::RenderTexture>();
+    if (width == 0 || height == 0 || !chunk.cache->create(width, height))
+    {
+        // Niente cache per questo chunk: si continua a disegnare i vertex array
+        std::cerr << "Could not create static layer cache " << width << "x" << height << std::endl;
+        chunk.cache.reset();
+        return;
+    }
+
+    // La vista della RenderTexture copre esattamente il chunk in coordinate mondo
+    chunk.cache->setView(sf::View(sf::FloatRect(chunk.bounds.left, chunk.bounds.top,
+                                                static_cast<float>(width), static_cast<float>(height))));
+    chunk.cache->clear(sf::Color::Transparent);
+    for (const auto& batch : chunk.batches)
+    {
+        sf::RenderStates states;
+        states.texture = batch.texture;
+        chunk.cache->draw(batch.vertices, states);
+    }
+    chunk.cache->display();
+
+    chunk.cacheSprite.setTexture(chunk.cache->getTexture(), true);
+    chunk.cacheSprite.setPosition(chunk.bounds.left, chunk.bounds.top);
+}
+
+void TileLayer::draw(sf::RenderTarget& target, const sf::FloatRect& visibleArea) const
+{
+    for (const auto& chunk : chunks)
+    {
+        if (!chunk.bounds.intersects(visibleArea))
+            continue;
+
+        if (chunk.cache)
+        {
+            target.draw(chunk.cacheSprite);
+            continue;
+        }
+
+        for (const auto& batch : chunk.batches)
+        {
+            sf::RenderStates states;
+            states.texture = batch.texture;
+            target.draw(batch.vertices, states);
+        }
+    }
+}
@@ -3,6 +3,8 @@
 #include <vector>
 #include <ctime>   // Per time()
 #include <cstdlib> // Per rand() e srand()
+#include <atomic>
+#include <thread>
 
 #ifdef __APPLE__
 #include <mach-o/dyld.h>   // Per _NSGetExecutablePath
@@ -18,11 +20,62 @@
 #include "Enemy.h"
 #include "LANDiscovery.h"
 #include "NetMessages.h"
+#include "TextureCache.h"
+#include "CharacterAtlas.h"
+#include "ParticleSystem.h"
+#include "AnimationClip.h"
+#include "RenderSnapshot.h"
+#include "SceneRenderer.h"
+#include "TripleBuffer.h"
+#include "Level.h"
 
-// Punti di spawn possibili per i nemici
-struct SpawnPoint {
-    float x, y;
-};
+// Simulazione a passo fisso: fisica, AI e invii di rete girano sempre a 60 Hz,
+// indipendentemente dal frame rate del render
+constexpr float SIMULATION_DT = 1.f / 60.f;
+// Snapshot dei nemici (host) al secondo: la banda non cresce con la simulazione
+constexpr float NET_TICK_RATE = 20.f;
+// Massimo di tick recuperati in un frame (evita la "spirale" se il gioco lagga)
+constexpr int MAX_TICKS_PER_FRAME = 5;
+
+// Mappa pre-renderizzata in texture off-screen: meno lavoro per frame sui PC lenti
+constexpr bool STATIC_LAYER_CACHE = true;
+
+// Render su un thread dedicato: la simulazione pubblica uno snapshot per frame e non
+// aspetta mai display() (vsync). Disattivato = tutto sul thread principale come prima.
+constexpr bool THREADED_RENDER = false;
+
+// Socket letto e scritto da un thread di rete: send lenti o raffiche di pacchetti
+// non allungano il frame. Disattivato = I/O dentro Scene::update e Game::update.
+constexpr bool NETWORK_THREAD = false;
+
+// Thread di render: disegna l'ultimo snapshot pubblicato (o ridisegna il precedente,
+// con l'interpolazione che avanza) finché 'running' resta true
+static void renderLoop(sf::RenderWindow& window, TripleBuffer<RenderSnapshot>& snapshots,
+                       const std::atomic<bool>& running)
+{
+    window.setActive(true);
+    SceneRenderer renderer;
+    renderer.setStaticLayerCache(STATIC_LAYER_CACHE);
+
+    bool hasSnapshot = false;
+    while (running)
+    {
+        if (snapshots.acquireLatest())
+            hasSnapshot = true;
+        if (!hasSnapshot)
+        {
+            sf::sleep(sf::milliseconds(1));
+            continue;
+        }
+
+        const RenderSnapshot& snapshot = snapshots.readBuffer();
+        window.clear(sf::Color::Cyan);
+        renderer.draw(window, snapshot, snapshot.alphaAt(RenderSnapshot::Clock::now()));
+        Game::getInstance()->drawHud(window, snapshot.hud);
+        window.display();
+    }
+    window.setActive(false);
+}
 
 int main()
 {
@@ -148,6 +201,9 @@ int main()
         std::cout << "Gioco in modalita' OFFLINE" << std::endl;
         isGameHost = true; // Offline = host dei nemici
     }
+    else if (NETWORK_THREAD) {
+        NetworkClient::getInstance()->startIoThread();
+    }
 
     // -----------------------------------------------------------
     // 2. CREAZIONE FINESTRA E GIOCO
@@ -168,125 +224,40 @@ int main()
     // -----------------------------------------------------------
     // 3. COSTRUZIONE DELLA SCENA
     // -----------------------------------------------------------
-    Scene* scene = new Scene();
+    Scene* scene = new Scene(*NetworkClient::getInstance());
+    scene->setStaticLayerCache(STATIC_LAYER_CACHE);
+    scene->setNetTickRate(NET_TICK_RATE);
     
     // Passiamo l'ID alla scena (fondamentale per filtrare i pacchetti)
     scene->setLocalPlayerId(myPlayerId); 
 
     // Creazione del Player Locale
-    auto localPlayer = std::make_unique<Player>("PM1", playerName, true);
+    auto localPlayer = std::make_unique<Player>(scene->getKinematics(), scene->getAnimator(), scene->getNetwork(), "PM1", playerName, true);
     localPlayer->setId(myPlayerId); // Assegniamo l'ID al nostro player così sa chi è quando invia i pacchetti
     scene->addEntity(std::move(localPlayer)); // Non serve più al main, lo passiamo alla scena
 
-    // Aggiunta Blocchi (Mappa)
-    // Funzione helper (lambda) per creare una fila di blocchi velocemente
-    auto createPlatform = [&](float startX, float startY, int numBlocks) {
-        for(int i = 0; i < numBlocks; i++) {
-            scene->addEntity(std::make_unique<Block>(
-                startX + (i * 15.0f),  // X: Si sposta di 15px per ogni blocco
-                startY,                // Y: Rimane fissa per la piattaforma
-                "assets/pp1/Blocks/block1.png"
-            ));
-        }
-    };
-    
-    // Funzione helper per creare muri verticali
-    auto createWall = [&](float startX, float startY, int numBlocks) {
-        for(int i = 0; i < numBlocks; i++) {
-            scene->addEntity(std::make_unique<Block>(
-                startX,
-                startY + (i * 15.0f),  // Y: Si sposta di 15px per ogni blocco
-                "assets/pp1/Blocks/block1.png"
-            ));
-        }
-    };
-    
-    // Piattaforme di gioco
-    createPlatform(100.0f, 450.0f, 40);
-    createPlatform(130.0f, 325.0f, 10);
-    createPlatform(520.0f, 325.0f, 10);
-    createPlatform(340.0f, 200.0f, 8);
-    
-    // -----------------------------------------------------------
-    // BLOCCHI AI BORDI (per evitare di cadere fuori mappa)
-    // -----------------------------------------------------------
-    // Pavimento in basso (tutta la larghezza)
-    createPlatform(0.0f, 550.0f, 54);
-    // Muro sinistro
-    createWall(0.0f, 0.0f, 40);
-    // Muro destro
-    createWall(785.0f, 0.0f, 40);
-    // Soffitto in alto
-    createPlatform(0.0f, 0.0f, 54);
+    // Mappa (piattaforme, bordi) ed effetti ambientali
+    Level::build(*scene);
 
-    // -----------------------------------------------------------
-    // SPAWN NEMICI IN PUNTI RANDOM
-    // -----------------------------------------------------------
-    // Definiamo i punti di spawn possibili (sulle piattaforme)
-    std::vector<SpawnPoint> spawnPoints = {
-        {150.0f, 420.0f},   // Piattaforma principale sinistra
-        {300.0f, 420.0f},   // Piattaforma principale centro-sinistra
-        {450.0f, 420.0f},   // Piattaforma principale centro-destra
-        {600.0f, 420.0f},   // Piattaforma principale destra
-        {180.0f, 295.0f},   // Piattaforma sinistra alta
-        {570.0f, 295.0f},   // Piattaforma destra alta
-        {380.0f, 170.0f},   // Piattaforma centrale più alta
-    };
-    
     // Solo l'HOST controlla i nemici e li sincronizza con i client
+    // (offline siamo sempre host; un server dedicato può toglierci il ruolo con HOST_ANNOUNCE)
     bool isOffline = !NetworkClient::getInstance()->isConnected();
-    bool isEnemyHost = isOffline || isGameHost; // Host o offline controlla i nemici
+    
+    // Pool nemici: tutte le istanze (e le texture) vengono create adesso,
+    // i cambi livello e il restart le riusano senza allocare né leggere da disco
+    scene->prewarmEnemies(Level::MaxEnemiesPerLevel);
     
     // Lambda per spawmare i nemici del livello corrente (solo per HOST)
     auto spawnEnemiesForLevel = [&](int level) {
         // I CLIENT non spawnano nemici - li riceveranno via rete
-        if (!isEnemyHost) {
+        if (!game->getIsHost()) {
             std::cout << "Client: aspetto nemici dall'host..." << std::endl;
             return;
         }
         
-        // Numero base di nemici + 2 per ogni livello
-        int numEnemies = 3 + (level * 2);
-        
-        // Massimo 15 nemici per evitare sovraccarico
-        if (numEnemies > 15) numEnemies = 15;
-        
+        int numEnemies = Level::spawnEnemies(*scene, level);
         game->setEnemiesToDefeat(numEnemies);
         
-        for (int i = 0; i < numEnemies; i++) {
-            // Scegli un punto di spawn random
-            int spawnIndex = std::rand() % spawnPoints.size();
-            SpawnPoint spawn = spawnPoints[spawnIndex];
-            
-            // Aggiungi una piccola variazione casuale alla X
-            float offsetX = static_cast<float>((std::rand() % 40) - 20);
-            
-            uint32_t enemyId = static_cast<uint32_t>(i + 1);
-            auto enemy = std::make_unique<Enemy>("PM2", enemyId, true); // Host controlla sempre
-            
-            float spawnX = spawn.x + offsetX;
-            float spawnY = spawn.y;
-            
-            // Impostiamo la posizione iniziale del nemico
-            enemy->setInitialPosition(spawnX, spawnY);
-            
-            // Se online, invia pacchetto spawn ai client
-            if (NetworkClient::getInstance()->isConnected()) {
-                PacketEnemySpawn spawnPacket;
-                spawnPacket.header.type = PacketType::ENEMY_SPAWN;
-                spawnPacket.header.packetSize = sizeof(PacketEnemySpawn);
-                spawnPacket.enemyId = enemyId;
-                spawnPacket.x = spawnX;
-                spawnPacket.y = spawnY;
-                spawnPacket.maxHealth = 100.f;
-                
-                NetworkClient::getInstance()->sendPacket(spawnPacket);
-                std::cout << "Inviato spawn nemico ID " << enemyId << " a (" << spawnX << ", " << spawnY << ")" << std::endl;
-            }
-            
-            scene->addEntity(std::move(enemy));
-        }
-        
         std::cout << "Livello " << level << " - Sconfiggi " << numEnemies << " nemici!" << std::endl;
     };
     
@@ -304,14 +275,34 @@ int main()
     // -----------------------------------------------------------
     // 4. GAME LOOP
     // -----------------------------------------------------------
+    // In modalità threaded il contesto OpenGL passa al thread di render;
+    // qui restano eventi, rete e simulazione
+    TripleBuffer<RenderSnapshot> snapshots;
+    std::atomic<bool> rendering(THREADED_RENDER);
+    std::thread renderThread;
+    if (THREADED_RENDER)
+    {
+        window.setActive(false);
+        renderThread = std::thread(renderLoop, std::ref(window), std::ref(snapshots), std::cref(rendering));
+    }
+    auto stopRenderThread = [&]() {
+        rendering = false;
+        if (renderThread.joinable())
+            renderThread.join();
+    };
+
     sf::Clock clock;
+    float accumulator = 0.f;
     while (window.isOpen())
     {
         sf::Event event;
         while (window.pollEvent(event))
         {
             if (event.type == sf::Event::Closed)
+            {
+                stopRenderThread(); // Il render non deve toccare la finestra mentre si chiude
                 window.close();
+            }
 
             if (event.type == sf::Event::GainedFocus) 
                 game->setFocus(true);
@@ -332,29 +323,50 @@ int main()
             }
         }
 
-        float dt = clock.restart().asSeconds();
-        if (dt > 0.05f) dt = 0.05f; // Limite per evitare glitch fisici se il gioco lagga
+        accumulator += clock.restart().asSeconds();
 
-        // Controlla se il livello è completato
-        if (game->isLevelComplete())
+        int ticks = 0;
+        while (accumulator >= SIMULATION_DT && ticks < MAX_TICKS_PER_FRAME)
         {
-            // Passa al livello successivo
-            game->nextLevel();
-            
-            // Rimuovi tutti i nemici esistenti
-            scene->removeAllEnemies();
-            
-            // Spawn nuovi nemici per il nuovo livello
-            spawnEnemiesForLevel(game->getCurrentLevel());
+            // Controlla se il livello è completato
+            if (game->isLevelComplete())
+            {
+                // Passa al livello successivo
+                game->nextLevel();
+                
+                // Rimuovi tutti i nemici esistenti
+                scene->removeAllEnemies();
+                
+                // Spawn nuovi nemici per il nuovo livello
+                spawnEnemiesForLevel(game->getCurrentLevel());
+            }
+
+            // Update Logica (Input, Fisica, Rete) con dt costante
+            game->update(SIMULATION_DT);
+
+            accumulator -= SIMULATION_DT;
+            ticks++;
         }
+        // Se siamo troppo indietro scartiamo il tempo residuo invece di accumularlo
+        if (ticks == MAX_TICKS_PER_FRAME && accumulator > SIMULATION_DT)
+            accumulator = 0.f;
 
-        // Update Logica (Input, Fisica, Rete)
-        game->update(dt);
+        if (THREADED_RENDER)
+        {
+            // Pubblica lo stato di questo frame: il thread di render disegnerà il più recente
+            scene->captureSnapshot(snapshots.writeBuffer(), accumulator / SIMULATION_DT);
+            snapshots.publish();
+            
+            // Nessun display() a fare da freno: dormi fino al prossimo tick
+            sf::sleep(sf::seconds(SIMULATION_DT - accumulator));
+            continue;
+        }
 
         // Render
         window.clear(sf::Color::Cyan);
         
-        // Disegna tutto quello che c'è nella scena
+        // Disegna tutto quello che c'è nella scena, interpolando fra gli ultimi due tick
+        scene->setRenderAlpha(accumulator / SIMULATION_DT);
         scene->draw(window);
         
         // Disegna l'interfaccia (contatore nemici, messaggio vittoria)
@@ -362,9 +374,14 @@ int main()
         
         window.display();
     }
+    stopRenderThread();
 
     // Pulizia finale
     Game::destroyInstance();         // Cancella Game (che cancella anche Scene)
     NetworkClient::destroyInstance(); // Cancella NetworkClient
+    TextureCache::destroyInstance();  // Dopo la Scene: nessuna entità usa più le texture
+    ParticleSystem::destroyInstance(); // Prima dell'atlas: tiene puntatori ai suoi frame
+    AnimationLibrary::destroyInstance();
+    CharacterAtlas::destroyInstance();
     return 0;
 }
\ No newline at end of file
@@ -6,6 +6,7 @@ namespace Dashboard;
 public partial class MainPage : ContentPage
 {
     private NetworkClient _client;
+    private CompactStateDecoder _compactState = new(); // baseline dei MoveCompact (thread rete)
     
     // Dati giocatori con info complete
     private Dictionary<uint, PlayerInfo> _players = new();
@@ -56,6 +57,7 @@ public partial class MainPage : ContentPage
             { 
                 _players.Clear();
                 _playerPositions.Clear();
+                _compactState.Clear();
             }
             _selectedPlayerId = null;
             UpdateAdminButtons();
@@ -71,23 +73,20 @@ public partial class MainPage : ContentPage
             uint id = BitConverter.ToUInt32(packet.Data, 0);
             float x = BitConverter.ToSingle(packet.Data, 4);
             float y = BitConverter.ToSingle(packet.Data, 8);
-
+            UpdatePlayerPosition(id, x, y);
+        }
+        // Move compatto (tutti i client della partita lo supportano): solo i campi cambiati
+        else if (packet.Type == PacketType.MoveCompact)
+        {
+            bool decoded;
+            uint id;
+            float x, y;
             lock (_players)
             {
-                if (!_players.ContainsKey(id))
-                {
-                    _players[id] = new PlayerInfo { Id = id, Name = $"Player {id}" };
-                    _playerListDirty = true;
-                    MainThread.BeginInvokeOnMainThread(() => 
-                        AddLog($" Nuovo giocatore: Player {id}"));
-                }
-                
-                _players[id].X = x;
-                _players[id].Y = y;
-                _players[id].LastUpdate = DateTime.Now;
-                
-                _playerPositions[id] = (x, y);
+                decoded = _compactState.TryReadMove(packet.Data, out id, out x, out y);
             }
+            if (decoded)
+                UpdatePlayerPosition(id, x, y);
         }
         else if (packet.Type == PacketType.PlayerDamage && packet.Data.Length >= 12)
         {
@@ -118,6 +117,7 @@ public partial class MainPage : ContentPage
             {
                 _players.Remove(id);
                 _playerPositions.Remove(id);
+                _compactState.Forget(id);
                 _playerListDirty = true;
             }
             
@@ -133,6 +133,27 @@ public partial class MainPage : ContentPage
         }
     }
 
+    // Thread Rete: posizione da Move o MoveCompact
+    private void UpdatePlayerPosition(uint id, float x, float y)
+    {
+        lock (_players)
+        {
+            if (!_players.ContainsKey(id))
+            {
+                _players[id] = new PlayerInfo { Id = id, Name = $"Player {id}" };
+                _playerListDirty = true;
+                MainThread.BeginInvokeOnMainThread(() => 
+                    AddLog($" Nuovo giocatore: Player {id}"));
+            }
+            
+            _players[id].X = x;
+            _players[id].Y = y;
+            _players[id].LastUpdate = DateTime.Now;
+            
+            _playerPositions[id] = (x, y);
+        }
+    }
+
     private void OnUpdateUiTick(object? sender, EventArgs e)
     {
         // 1. Ridisegna Radar
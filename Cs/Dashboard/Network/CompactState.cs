@@ -0,0 +1,101 @@
+namespace Dashboard.Network;
+
+// Decodifica dei MoveCompact, speculare a Cpp/net/NetCompact.cpp: stessi bit, stessa quantizzazione.
+// Body: playerId (uint32) + record [completo:1] [maschera:6 se delta] [campi presenti].
+// I delta valgono rispetto all'ultimo stato ricevuto da quel player (baseline).
+public class CompactStateDecoder
+{
+    // Bordi del livello (Level::Width/Height in C++) più il margine oltre la mappa
+    private const float BoundsMargin = 100f;
+    private const float LevelWidth = 800f;
+    private const float LevelHeight = 600f;
+
+    private const int FieldX = 1 << 0;
+    private const int FieldY = 1 << 1;
+    private const int FieldVelocityX = 1 << 2;
+    private const int FieldVelocityY = 1 << 3;
+    private const int FieldFlags = 1 << 4;
+    private const int FieldHealth = 1 << 5;
+    private const int FieldCount = 6;
+    private const int FlagBits = 3;
+
+    private struct QuantizedState
+    {
+        public ushort X, Y;
+        public short VelocityX, VelocityY;
+        public byte Flags, Health;
+    }
+
+    private readonly Dictionary<uint, QuantizedState> _baselines = new();
+
+    // False se il pacchetto è troncato o è un delta senza baseline (si aspetta il keyframe)
+    public bool TryReadMove(byte[] body, out uint playerId, out float x, out float y)
+    {
+        x = y = 0f;
+        playerId = 0;
+        if (body.Length < 4) return false;
+        playerId = BitConverter.ToUInt32(body, 0);
+
+        var reader = new BitReader(body, 4);
+        bool full = reader.Read(1) != 0;
+        int mask = full
+            ? FieldX | FieldY | FieldVelocityX | FieldVelocityY | FieldFlags
+            : (int)reader.Read(FieldCount);
+
+        bool hasBaseline = _baselines.TryGetValue(playerId, out var state);
+        if (!full && !hasBaseline) return false;
+        if (full) state = new QuantizedState();
+
+        if ((mask & FieldX) != 0) state.X = (ushort)reader.Read(16);
+        if ((mask & FieldY) != 0) state.Y = (ushort)reader.Read(16);
+        if ((mask & FieldVelocityX) != 0) state.VelocityX = (short)reader.Read(16);
+        if ((mask & FieldVelocityY) != 0) state.VelocityY = (short)reader.Read(16);
+        if ((mask & FieldFlags) != 0) state.Flags = (byte)reader.Read(FlagBits);
+        if ((mask & FieldHealth) != 0) state.Health = (byte)reader.Read(8);
+        if (reader.Failed) return false;
+
+        _baselines[playerId] = state;
+        x = -BoundsMargin + (LevelWidth + 2f * BoundsMargin) * (state.X / 65535f);
+        y = -BoundsMargin + (LevelHeight + 2f * BoundsMargin) * (state.Y / 65535f);
+        return true;
+    }
+
+    public void Forget(uint playerId) => _baselines.Remove(playerId);
+
+    public void Clear() => _baselines.Clear();
+
+    // Bit meno significativo per primo, come BitReader in C++
+    private class BitReader
+    {
+        private readonly byte[] _data;
+        private int _bitPos;
+        private readonly int _bitSize;
+
+        public bool Failed { get; private set; }
+
+        public BitReader(byte[] data, int byteOffset)
+        {
+            _data = data;
+            _bitPos = byteOffset * 8;
+            _bitSize = data.Length * 8;
+        }
+
+        public uint Read(int bits)
+        {
+            if (_bitPos + bits > _bitSize)
+            {
+                Failed = true;
+                _bitPos = _bitSize;
+                return 0;
+            }
+            uint value = 0;
+            for (int i = 0; i < bits; i++)
+            {
+                if ((_data[_bitPos / 8] & (1 << (_bitPos % 8))) != 0)
+                    value |= 1u << i;
+                _bitPos++;
+            }
+            return value;
+        }
+    }
+}
@@ -26,6 +26,9 @@ public class NetworkClient
 
             OnLog?.Invoke($" Connesso a {ip}:{port}");
 
+            // Hello: il server ci inoltra anche i Move compatti (li decodifichiamo per il radar)
+            await SendAsync(GamePacket.CreateHelloPacket(NetCapability.CompactState));
+
             // Avvia il loop
             // Nota: _cts non può essere null qui, ma per sicurezza usiamo il ? o ! se necessario
             if (_cts != null)
@@ -16,6 +16,12 @@ public enum PacketType : uint
     PlayerAttack = 8,
     HostAnnounce = 9,
     PlayerDamage = 10,
+    Ping = 11,
+    EnemySnapshot = 12,
+    MoveCompact = 13,          // Come Move, quantizzato e delta (vedi CompactState.cs)
+    EnemySnapshotCompact = 14,
+    NetCaps = 15,
+    Hello = 16,                // Capacità del client, subito dopo la connessione
     
     // Comandi Admin (100+)
     AdminKick = 100,      // Kicka un giocatore
@@ -24,6 +30,14 @@ public enum PacketType : uint
     AdminSpawnEnemy = 103 // Spawna un nemico
 }
 
+// Capacità dichiarate nell'Hello (NetCapability in C++)
+[Flags]
+public enum NetCapability : uint
+{
+    None = 0,
+    CompactState = 1 << 0 // Sa leggere MoveCompact (la dashboard ne decodifica le posizioni)
+}
+
 // Info su un giocatore per la dashboard
 public class PlayerInfo
 {
@@ -58,6 +72,13 @@ public class GamePacket
         return ms.ToArray();
     }
     
+    // Helper per creare pacchetto Hello: senza, il server conta la dashboard come un
+    // client vecchio e spegne lo stato compatto per tutta la partita
+    public static byte[] CreateHelloPacket(NetCapability capabilities)
+    {
+        return Serialize(PacketType.Hello, BitConverter.GetBytes((uint)capabilities));
+    }
+    
     // Helper per creare pacchetto Kick
     public static byte[] CreateKickPacket(uint playerId)
     {
@@ -1,6 +1,7 @@
 package main
 
 import (
+	"bufio"
 	"encoding/binary"
 	"fmt"
 	"io"
@@ -28,6 +29,14 @@ const (
 	PACKET_PLAYER_ATTACK       = 8
 	PACKET_HOST_ANNOUNCE       = 9
 	PACKET_PLAYER_DAMAGE       = 10
+	PACKET_PING                = 11
+	PACKET_ENEMY_SNAPSHOT      = 12 // dimensione variabile (<= 1024 byte), inoltrato come gli altri
+
+	// Stato compatto (quantizzato e a delta): solo fra client che lo hanno negoziato
+	PACKET_MOVE_COMPACT           = 13
+	PACKET_ENEMY_SNAPSHOT_COMPACT = 14
+	PACKET_NET_CAPS               = 15
+	PACKET_HELLO                  = 16 // capacità del client: consumato qui, mai inoltrato
 
 	// Comandi Admin (100+)
 	PACKET_ADMIN_KICK        = 100
@@ -36,11 +45,22 @@ const (
 	PACKET_ADMIN_SPAWN_ENEMY = 103
 )
 
+// Capacità dichiarate dai client nell'HELLO (deve corrispondere a NetCapability in C++)
+const (
+	CAP_COMPACT_STATE = 1 << 0
+
+	// Un client che non manda l'HELLO entro questo tempo è un client vecchio
+	HELLO_TIMEOUT = 2 * time.Second
+)
+
 // Struttura Client: rappresenta un giocatore connesso
 type Client struct {
 	conn net.Conn
 	id   uint32
 	ip   string // IP per ban
+
+	caps    uint32 // capacità dichiarate nell'HELLO (0 = client vecchio)
+	settled bool   // HELLO ricevuto (o scaduto HELLO_TIMEOUT): conta nelle capacità comuni
 }
 
 // Stato globale del server
@@ -49,6 +69,10 @@ var (
 	clientsMu sync.Mutex                     // Mutex per evitare crash quando due goroutine scrivono sulla mappa
 	nextID    uint32                     = 1 // Contatore per assegnare ID univoci
 
+	// Capacità comuni (NET_CAPS), protette da clientsMu
+	capsEpoch  uint32 // Incrementato ad ogni NET_CAPS
+	commonCaps uint32 // Capacità comuni dell'ultimo NET_CAPS
+
 	// Lista IP bannati (persistente in memoria, si resetta al riavvio)
 	bannedIPs   = make(map[string]bool)
 	bannedIPsMu sync.Mutex
@@ -217,6 +241,22 @@ func handleClient(conn net.Conn) {
 	conn.Write(welcomePacket)
 	fmt.Printf("   Inviato ID %d al client\n", id)
 
+	// Le capacità comuni si ricalcolano all'arrivo del suo HELLO, non adesso: così un
+	// nuovo client non riporta per un attimo tutta la sessione al formato vecchio.
+	// Se l'HELLO non arriva è un client vecchio, e conta come tale.
+	time.AfterFunc(HELLO_TIMEOUT, func() {
+		clientsMu.Lock()
+		expired := clients[id] == client && !client.settled
+		if expired {
+			client.settled = true
+		}
+		clientsMu.Unlock()
+		if expired {
+			fmt.Printf("Nessun HELLO da ID %d: client senza capacità\n", id)
+			broadcastCaps(true)
+		}
+	})
+
 	// Assicurati di rimuovere il client quando la funzione finisce (disconnessione)
 	defer func() {
 		clientsMu.Lock()
@@ -224,17 +264,21 @@ func handleClient(conn net.Conn) {
 		clientsMu.Unlock()
 		conn.Close()
 		fmt.Printf("Giocatore Disconnesso: ID %d\n", id)
+		broadcastCaps(false)
 
 		// Notifica tutti della disconnessione
 		broadcastPlayerDisconnected(id)
 	}()
 
 	// 4. Loop di lettura messaggi dal client
+	// Lettura bufferizzata: i client spediscono tutti i pacchetti di un frame in una sola
+	// scrittura, così header e body di più pacchetti arrivano con una sola read
+	reader := bufio.NewReaderSize(conn, 16*1024)
 	for {
 		// A. Leggi l'Header (8 Byte: 4 per Type + 4 per Size)
 		// Usiamo LittleEndian perché i PC standard (x86/64) usano questo formato
 		var header PacketHeader
-		err := binary.Read(conn, binary.LittleEndian, &header)
+		err := binary.Read(reader, binary.LittleEndian, &header)
 		if err != nil {
 			if err != io.EOF {
 				fmt.Printf("Errore lettura header ID %d: %v\n", id, err)
@@ -252,12 +296,26 @@ func handleClient(conn net.Conn) {
 		// C. Leggi il Corpo del pacchetto (Size - 8 bytes di header già letti)
 		bodySize := header.PacketSize - 8
 		body := make([]byte, bodySize)
-		_, err = io.ReadFull(conn, body)
+		_, err = io.ReadFull(reader, body)
 		if err != nil {
 			fmt.Printf("Errore lettura body ID %d: %v\n", id, err)
 			return
 		}
 
+		// HELLO: il client dichiara le sue capacità. Non si inoltra
+		if header.Type == PACKET_HELLO {
+			if len(body) >= 4 {
+				caps := binary.LittleEndian.Uint32(body[0:4])
+				clientsMu.Lock()
+				client.caps = caps
+				client.settled = true
+				clientsMu.Unlock()
+				fmt.Printf("HELLO da ID %d: capacità 0x%x\n", id, caps)
+				broadcastCaps(true)
+			}
+			continue
+		}
+
 		// D. Logica server: Qui potremmo modificare il pacchetto
 		// Il server forza l'ID del pacchetto per sicurezza (prevenendo impersonificazioni)
 		// (Il campo playerId è il primo campo (uint32) dopo l'header nel tuo MovePacket)
@@ -266,12 +324,23 @@ func handleClient(conn net.Conn) {
 			binary.LittleEndian.PutUint32(body[0:4], id)
 		}
 
+		// Stesso discorso per MOVE_COMPACT (playerId subito dopo l'header)
+		if header.Type == PACKET_MOVE_COMPACT && len(body) >= 4 {
+			binary.LittleEndian.PutUint32(body[0:4], id)
+		}
+
 		// Forza l'ID anche per PLAYER_ATTACK (il playerId è il primo campo del body)
 		if header.Type == PACKET_PLAYER_ATTACK {
 			binary.LittleEndian.PutUint32(body[0:4], id)
 			fmt.Printf("PLAYER_ATTACK da ID %d inoltrato\n", id)
 		}
 
+		// Forza l'ID anche per HOST_ANNOUNCE: si può annunciare solo se stessi (es. il server dedicato)
+		if header.Type == PACKET_HOST_ANNOUNCE && len(body) >= 4 {
+			binary.LittleEndian.PutUint32(body[0:4], id)
+			fmt.Printf("HOST_ANNOUNCE: ID %d controlla i nemici\n", id)
+		}
+
 		// NON sovrascrivere l'ID per PLAYER_DAMAGE - l'ID è del player che subisce danno, non del mittente
 		if header.Type == PACKET_PLAYER_DAMAGE {
 			targetId := binary.LittleEndian.Uint32(body[0:4])
@@ -303,6 +372,18 @@ func handleClient(conn net.Conn) {
 		// Copia il body
 		copy(fullPacket[8:], body)
 
+		// PING: torna solo al mittente (misura della latenza dei client/bot)
+		if header.Type == PACKET_PING {
+			sendTo(fullPacket, id)
+			continue
+		}
+
+		// Stato compatto: i client vecchi non saprebbero saltarlo, va solo a chi lo ha negoziato
+		if header.Type == PACKET_MOVE_COMPACT || header.Type == PACKET_ENEMY_SNAPSHOT_COMPACT {
+			broadcastCapable(fullPacket, id, CAP_COMPACT_STATE)
+			continue
+		}
+
 		// PLAYER_DAMAGE va inviato a TUTTI (incluso il mittente) così l'host aggiorna il player remoto
 		if header.Type == PACKET_PLAYER_DAMAGE {
 			broadcastToAll(fullPacket)
@@ -328,6 +409,63 @@ func broadcast(data []byte, senderID uint32) {
 	}
 }
 
+// Come broadcast, ma solo ai client che hanno dichiarato la capacità indicata
+func broadcastCapable(data []byte, senderID uint32, capability uint32) {
+	clientsMu.Lock()
+	defer clientsMu.Unlock()
+
+	for id, client := range clients {
+		if id != senderID && client.caps&capability != 0 {
+			_, err := client.conn.Write(data)
+			if err != nil {
+				fmt.Printf("Errore invio a ID %d\n", id)
+			}
+		}
+	}
+}
+
+// Ricalcola le capacità comuni ai client che hanno già mandato l'HELLO (un client vecchio
+// le azzera) e le comunica con NET_CAPS a chi le ha dichiarate. L'epoch nuovo fa ripartire
+// i delta da stati completi: serve quando entra qualcuno (newClient), che altrimenti non
+// avrebbe baseline, oppure quando le capacità comuni cambiano.
+func broadcastCaps(newClient bool) {
+	clientsMu.Lock()
+	defer clientsMu.Unlock()
+
+	var common uint32 = ^uint32(0)
+	settled := 0
+	for _, client := range clients {
+		if client.settled {
+			common &= client.caps
+			settled++
+		}
+	}
+	if settled == 0 {
+		common = 0
+	}
+	if common == commonCaps && !newClient {
+		return
+	}
+	commonCaps = common
+	capsEpoch++
+
+	packet := make([]byte, 16)
+	binary.LittleEndian.PutUint32(packet[0:4], PACKET_NET_CAPS)
+	binary.LittleEndian.PutUint32(packet[4:8], 16)
+	binary.LittleEndian.PutUint32(packet[8:12], common)
+	binary.LittleEndian.PutUint32(packet[12:16], capsEpoch)
+
+	for id, client := range clients {
+		if client.caps == 0 {
+			continue // Client vecchio (o HELLO non ancora arrivato): non conosce NET_CAPS
+		}
+		_, err := client.conn.Write(packet)
+		if err != nil {
+			fmt.Printf("Errore invio a ID %d\n", id)
+		}
+	}
+}
+
 // Invia il pacchetto a TUTTI i client (incluso il mittente)
 func broadcastToAll(data []byte) {
 	clientsMu.Lock()
@@ -341,6 +479,19 @@ func broadcastToAll(data []byte) {
 	}
 }
 
+// Invia il pacchetto solo al client indicato
+func sendTo(data []byte, targetID uint32) {
+	clientsMu.Lock()
+	defer clientsMu.Unlock()
+
+	if client, exists := clients[targetID]; exists {
+		_, err := client.conn.Write(data)
+		if err != nil {
+			fmt.Printf("Errore invio a ID %d\n", targetID)
+		}
+	}
+}
+
 // Notifica tutti che un player si è disconnesso
 func broadcastPlayerDisconnected(playerId uint32) {
 	packet := make([]byte, 12)